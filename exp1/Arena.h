@@ -0,0 +1,126 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>     // std::size_t, std::max_align_t
+#include <cstdint>     // std::uintptr_t
+#include <cstdlib>     // std::malloc, std::free
+#include <new>         // std::bad_alloc
+#include <type_traits> // std::true_type
+
+// 单调分配区：从大块内存中顺序切分，单次分配只需移动指针；
+// 各次分配不单独释放，reset() 一次性回收全部空间
+class Arena {
+    struct Block { // 内存块，数据紧随块头之后
+        Block* next;
+        std::size_t size; // 数据区字节数
+        char* data() { return reinterpret_cast<char*>(this + 1); }
+    };
+
+    Block* _head;           // 最近分配的块
+    char* _cur;             // 当前块中的空闲起点
+    char* _end;             // 当前块的末尾
+    std::size_t _blockSize; // 常规块的大小
+    std::size_t _used;      // 已分配的字节数(含对齐填充)
+
+    // 追加一个至少可容纳 bytes 字节(按 align 对齐)的新块
+    void grow(std::size_t bytes, std::size_t align) {
+        std::size_t size = bytes + align > _blockSize ? bytes + align : _blockSize;
+        Block* b = static_cast<Block*>(std::malloc(sizeof(Block) + size));
+        if (!b) throw std::bad_alloc();
+        b->next = _head;
+        b->size = size;
+        _head = b;
+        _cur = b->data();
+        _end = _cur + size;
+    }
+
+public:
+    explicit Arena(std::size_t blockSize = 64 * 1024)
+        : _head(nullptr), _cur(nullptr), _end(nullptr), _blockSize(blockSize), _used(0) {}
+    ~Arena() { release(); }
+    Arena(Arena const&) = delete;
+    Arena& operator=(Arena const&) = delete;
+
+    // 分配 bytes 字节，按 align 对齐
+    void* allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t)) {
+        std::uintptr_t p = (reinterpret_cast<std::uintptr_t>(_cur) + align - 1) & ~(std::uintptr_t(align) - 1);
+        if (!_cur || p + bytes > reinterpret_cast<std::uintptr_t>(_end)) {
+            grow(bytes, align);
+            p = (reinterpret_cast<std::uintptr_t>(_cur) + align - 1) & ~(std::uintptr_t(align) - 1);
+        }
+        _used += p + bytes - reinterpret_cast<std::uintptr_t>(_cur);
+        _cur = reinterpret_cast<char*>(p + bytes);
+        return reinterpret_cast<void*>(p);
+    }
+
+    // 释放：只有最近一次分配可以退回(如向量扩容前后的缓冲区)，其余留待 reset()
+    void deallocate(void* p, std::size_t bytes) {
+        if (static_cast<char*>(p) + bytes == _cur) {
+            _cur = static_cast<char*>(p);
+            _used -= bytes;
+        }
+    }
+
+    // 回收全部分配：只保留最大的一块供后续复用，其余归还系统
+    void reset() {
+        Block* keep = _head;
+        for (Block* b = _head; b; b = b->next)
+            if (b->size > keep->size) keep = b;
+        for (Block* b = _head; b; ) {
+            Block* next = b->next;
+            if (b != keep) std::free(b);
+            b = next;
+        }
+        _head = keep;
+        if (keep) {
+            keep->next = nullptr;
+            _cur = keep->data();
+            _end = _cur + keep->size;
+        }
+        _used = 0;
+    }
+
+    // 将全部内存归还系统
+    void release() {
+        while (_head) {
+            Block* next = _head->next;
+            std::free(_head);
+            _head = next;
+        }
+        _cur = _end = nullptr;
+        _used = 0;
+    }
+
+    std::size_t used() const { return _used; } // 已分配的字节数
+};
+
+// 从 Arena 中分配的分配器，可作为 Vector 的 Alloc 参数；
+// 同一分配区的分配器彼此相等，移动赋值时随容器转移
+template <typename T>
+class ArenaAllocator {
+    template <typename> friend class ArenaAllocator;
+    Arena* _arena;
+
+public:
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+
+    ArenaAllocator(Arena& arena) noexcept : _arena(&arena) {}
+    template <typename U>
+    ArenaAllocator(ArenaAllocator<U> const& a) noexcept : _arena(a._arena) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T* p, std::size_t n) noexcept {
+        _arena->deallocate(p, n * sizeof(T));
+    }
+    Arena& arena() const { return *_arena; }
+
+    template <typename U>
+    bool operator==(ArenaAllocator<U> const& a) const { return _arena == a._arena; }
+    template <typename U>
+    bool operator!=(ArenaAllocator<U> const& a) const { return _arena != a._arena; }
+};
+
+#endif // ARENA_H
@@ -0,0 +1,280 @@
+// Vector 各算法的基准测试
+// 规模自 10^2 至 10^8 逐级扩大十倍，数据分布为有序、逆序、随机与大量重复，
+// 对每种组合报告每元素耗时(ns)、比较次数、移动次数与堆分配次数，结果以 JSON 输出，
+// 便于比较不同版本之间的性能变化
+//
+// 用法：vector_bench [--max-n N] [--quadratic-max N] [--count-max N]
+//                    [--algo 名称] [--dist 名称] [--out 文件]
+
+#include <atomic>    // std::atomic
+#include <chrono>    // std::chrono::steady_clock
+#include <cmath>     // std::sqrt
+#include <cstdio>    // std::printf, std::fprintf, std::fopen
+#include <cstdlib>   // std::atoll, std::malloc, std::free
+#include <cstring>   // std::strcmp
+#include <functional> // std::hash
+#include <memory>    // std::allocator
+#include <new>       // std::bad_alloc
+#include <vector>    // std::vector
+#include "Vector.h"
+
+namespace {
+
+// 计数器：比较、移动(复制构造与赋值)、堆分配
+struct Counter {
+    long long comparisons;
+    long long moves;
+    long long allocations;
+} counter;
+
+// 堆分配由下面替换的全局 operator new 计数，仅在 countingHeap 为真时计入；
+// 算法可能在线程池中分配，故用原子量
+std::atomic<bool> countingHeap(false);
+std::atomic<long long> heapAllocations(0);
+
+// 带计数的元素：除比较与复制时计数外与 int 无异
+struct Counted {
+    int v;
+    Counted(int v = 0) : v(v) {}
+    Counted(Counted const& e) : v(e.v) { ++counter.moves; }
+    Counted& operator=(Counted const& e) { v = e.v; ++counter.moves; return *this; }
+};
+
+bool operator<(Counted const& a, Counted const& b) { ++counter.comparisons; return a.v < b.v; }
+bool operator>(Counted const& a, Counted const& b) { ++counter.comparisons; return a.v > b.v; }
+bool operator!=(Counted const& a, Counted const& b) { ++counter.comparisons; return a.v != b.v; }
+
+} // namespace
+
+namespace std {
+template <>
+struct hash<Counted> {
+    size_t operator()(Counted const& e) const { return hash<int>()(e.v); }
+};
+} // namespace std
+
+// 替换全局的 operator new/delete：除 Vector 自身的扩容外，归并排序的缓冲、基数排序的 new T[]、
+// 去重的散列表等一切堆分配都经由此处，因而都被计入；operator new[] 与 nothrow 版本默认转调此函数
+// 均不内联：内联后 GCC 看到其中的 malloc/free，会误报 -Wstringop-overflow 与 -Wmismatched-new-delete
+#if defined(__GNUC__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+BENCH_NOINLINE void* operator new(std::size_t size) {
+    if (countingHeap.load(std::memory_order_relaxed)) heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+BENCH_NOINLINE void operator delete(void* p) noexcept { std::free(p); }
+BENCH_NOINLINE void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// 公开 Vector 受保护的排序算法，以便逐一测试
+template <typename T, typename Alloc = std::allocator<T>>
+class BenchVector : public Vector<T, Alloc> {
+public:
+    using Vector<T, Alloc>::Vector;
+    using Vector<T, Alloc>::bubbleSort;
+    using Vector<T, Alloc>::selectionSort;
+    using Vector<T, Alloc>::mergeSort;
+    using Vector<T, Alloc>::quickSort;
+    using Vector<T, Alloc>::heapSort;
+};
+
+enum Algo { BUBBLE, SELECTION, MERGE, QUICK, HEAP, SEARCH, FIND, APPEND, INSERT, REMOVE, DEDUPLICATE, UNIQUIFY, ALGOS };
+const char* const ALGO_NAME[ALGOS] = {
+    "bubbleSort", "selectionSort", "mergeSort", "quickSort", "heapSort",
+    "search", "find", "append", "insert", "remove", "deduplicate", "uniquify"
+};
+const bool QUADRATIC[ALGOS] = { true, true, false, false, false, false, false, false, false, false, false, false };
+
+enum Dist { SORTED, REVERSED, RANDOM, DUPLICATES, DISTS };
+const char* const DIST_NAME[DISTS] = { "sorted", "reversed", "random", "duplicates" };
+
+const Rank FIND_QUERIES = 16;   // find 的查找次数(每次 O(n))
+const Rank INSERT_COUNT = 64;   // insert 的插入次数(每次 O(n))
+const Rank REMOVE_COUNT = 64;   // remove 的删除次数(每次 O(n))
+const double MIN_SECONDS = 0.05; // 每项至少累计运行的时间
+const int MAX_REPEATS = 1000;    // 每项至多重复的次数
+
+volatile long long sink; // 防止查找结果被优化掉
+
+// 生成规模为 n、分布为 dist 的数据
+std::vector<int> generate(Dist dist, Rank n, dsa::Random& rng) {
+    std::vector<int> data(n);
+    std::uint32_t distinct = static_cast<std::uint32_t>(std::sqrt(static_cast<double>(n))) + 1;
+    for (Rank i = 0; i < n; ++i) {
+        switch (dist) {
+        case SORTED: data[i] = i; break;
+        case REVERSED: data[i] = n - i; break;
+        case RANDOM: data[i] = static_cast<int>(rng.below(0x7FFFFFFF)); break;
+        default: data[i] = static_cast<int>(rng.below(distinct)); break; // 约 sqrt(n) 种取值
+        }
+    }
+    return data;
+}
+
+// 一次测试的输入：向量、查找或插入的元素、插入或删除的秩
+template <typename E>
+struct Case {
+    BenchVector<E> v;
+    std::vector<E> items;
+    std::vector<Rank> ranks;
+
+    Case(Algo algo, std::vector<int> const& data, dsa::Random& rng) {
+        Rank n = static_cast<Rank>(data.size());
+        if (algo == APPEND) { // 自空向量逐个追加，测扩容
+            items.assign(data.begin(), data.end());
+            return;
+        }
+        v.reserve(n);
+        for (Rank i = 0; i < n; ++i) v.insert(E(data[i]));
+        if (algo == SEARCH || algo == UNIQUIFY) v.sort();
+        if (algo == SEARCH) // n 次查找，约一半命中
+            for (Rank i = 0; i < n; ++i)
+                items.push_back(i & 1 ? E(data[rng.below(n)]) : E(static_cast<int>(rng.below(0x7FFFFFFF))));
+        if (algo == FIND) // 命中与落空各半
+            for (Rank i = 0; i < FIND_QUERIES; ++i)
+                items.push_back(i & 1 ? E(data[rng.below(n)]) : E(-1));
+        if (algo == INSERT) // 在随机秩处插入，测后缀的整体后移(makeGap)
+            for (Rank i = 0; i < INSERT_COUNT; ++i) {
+                items.push_back(E(data[rng.below(n)]));
+                ranks.push_back(static_cast<Rank>(rng.below(n + i + 1)));
+            }
+        if (algo == REMOVE)
+            for (Rank i = 0; i < REMOVE_COUNT && i < n; ++i)
+                ranks.push_back(static_cast<Rank>(rng.below(n - i)));
+    }
+
+    // 执行被测操作，返回操作的元素数
+    long long run(Algo algo) {
+        Rank n = v.size();
+        long long acc = 0;
+        switch (algo) {
+        case BUBBLE: v.bubbleSort(0, n); return n;
+        case SELECTION: v.selectionSort(0, n); return n;
+        case MERGE: v.mergeSort(0, n); return n;
+        case QUICK: v.quickSort(0, n); return n;
+        case HEAP: v.heapSort(0, n); return n;
+        case SEARCH:
+            for (E const& e : items) acc += v.search(e);
+            sink = acc;
+            return static_cast<long long>(items.size());
+        case FIND:
+            for (E const& e : items) acc += v.find(e);
+            sink = acc;
+            return static_cast<long long>(items.size());
+        case APPEND:
+            for (E const& e : items) v.insert(e);
+            return static_cast<long long>(items.size());
+        case INSERT:
+            for (size_t i = 0; i < ranks.size(); ++i) v.insert(ranks[i], items[i]);
+            return static_cast<long long>(ranks.size());
+        case REMOVE:
+            for (Rank r : ranks) v.remove(r);
+            return static_cast<long long>(ranks.size());
+        case DEDUPLICATE: v.deduplicate(); return n;
+        case UNIQUIFY: v.uniquify(); return n;
+        default: return 0;
+        }
+    }
+};
+
+struct Result {
+    double nsPerElement;
+    long long ops;
+    int repeats;
+    bool counted;
+    Counter count;
+};
+
+// 以 int 计时(取多次中的最短者)，再以 Counted 运行一次计数
+Result measure(Algo algo, std::vector<int> const& data, bool count) {
+    typedef std::chrono::steady_clock Clock;
+    Result result = {};
+    dsa::Random rng(42);
+    double best = 0, total = 0;
+    while (result.repeats < MAX_REPEATS && (result.repeats == 0 || total < MIN_SECONDS)) {
+        Case<int> c(algo, data, rng);
+        Clock::time_point start = Clock::now();
+        result.ops = c.run(algo);
+        double t = std::chrono::duration<double>(Clock::now() - start).count();
+        if (result.repeats++ == 0 || t < best) best = t;
+        total += t;
+    }
+    result.nsPerElement = result.ops > 0 ? best * 1e9 / result.ops : 0;
+    if (count) {
+        dsa::Random crng(42);
+        Case<Counted> c(algo, data, crng);
+        counter = Counter();
+        heapAllocations = 0;
+        countingHeap = true;
+        c.run(algo);
+        countingHeap = false;
+        counter.allocations = heapAllocations;
+        result.count = counter;
+        result.counted = true;
+    }
+    return result;
+}
+
+long long argValue(int argc, char** argv, char const* name, long long fallback) {
+    for (int i = 1; i + 1 < argc; ++i)
+        if (!std::strcmp(argv[i], name)) return std::atoll(argv[i + 1]);
+    return fallback;
+}
+
+char const* argString(int argc, char** argv, char const* name) {
+    for (int i = 1; i + 1 < argc; ++i)
+        if (!std::strcmp(argv[i], name)) return argv[i + 1];
+    return nullptr;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    long long maxN = argValue(argc, argv, "--max-n", 100000000);         // 最大规模
+    long long quadraticMax = argValue(argc, argv, "--quadratic-max", 10000); // O(n^2) 算法的最大规模
+    long long countMax = argValue(argc, argv, "--count-max", 10000000);  // 计数运行的最大规模
+    char const* onlyAlgo = argString(argc, argv, "--algo");
+    char const* onlyDist = argString(argc, argv, "--dist");
+    char const* outPath = argString(argc, argv, "--out");
+
+    std::FILE* out = outPath ? std::fopen(outPath, "w") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "cannot open %s\n", outPath);
+        return 1;
+    }
+    std::fprintf(out, "{\n  \"compiler\": \"%s\",\n  \"results\": [", __VERSION__);
+    bool first = true;
+    for (long long n = 100; n <= maxN; n *= 10) {
+        for (int d = 0; d < DISTS; ++d) {
+            if (onlyDist && std::strcmp(onlyDist, DIST_NAME[d])) continue;
+            dsa::Random rng(static_cast<std::uint64_t>(n) * DISTS + d);
+            std::vector<int> data = generate(static_cast<Dist>(d), static_cast<Rank>(n), rng);
+            for (int a = 0; a < ALGOS; ++a) {
+                if (onlyAlgo && std::strcmp(onlyAlgo, ALGO_NAME[a])) continue;
+                if (QUADRATIC[a] && n > quadraticMax) continue;
+                Result r = measure(static_cast<Algo>(a), data, n <= countMax);
+                std::fprintf(stderr, "%-14s %-11s n=%-10lld %10.2f ns/element\n", ALGO_NAME[a], DIST_NAME[d], n, r.nsPerElement);
+                std::fprintf(out, "%s\n    {\"algorithm\": \"%s\", \"distribution\": \"%s\", \"n\": %lld, "
+                                  "\"ops\": %lld, \"repeats\": %d, \"ns_per_element\": %.3f",
+                             first ? "" : ",", ALGO_NAME[a], DIST_NAME[d], n, r.ops, r.repeats, r.nsPerElement);
+                if (r.counted)
+                    std::fprintf(out, ", \"comparisons\": %lld, \"moves\": %lld, \"allocations\": %lld}",
+                                 r.count.comparisons, r.count.moves, r.count.allocations);
+                else
+                    std::fprintf(out, ", \"comparisons\": null, \"moves\": null, \"allocations\": null}");
+                std::fflush(out);
+                first = false;
+            }
+        }
+    }
+    std::fprintf(out, "\n  ]\n}\n");
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
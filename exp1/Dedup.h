@@ -0,0 +1,100 @@
+#ifndef DEDUP_H
+#define DEDUP_H
+
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint64_t
+#include <functional>  // std::hash
+#include <type_traits> // std::true_type, std::false_type
+#include <utility>     // std::declval, std::move
+#include <vector>      // std::vector
+
+typedef int Rank; // 秩
+
+// 基于散列的无序去重：保留各元素的首次出现，并保持其相对次序
+namespace dsa {
+
+// T 是否可用 std::hash 散列
+template <typename T, typename = void>
+struct IsHashable : std::false_type {};
+template <typename T>
+struct IsHashable<T, decltype(void(std::hash<T>()(std::declval<T const&>())))> : std::true_type {};
+
+// 线性试探的散列表，只记录元素的秩；元素本身仍存放于原数组
+class RankTable {
+    std::vector<Rank> _slot; // -1 表示空桶
+    int _bits;
+    Rank _count;
+public:
+    explicit RankTable(Rank n) : _bits(1), _count(0) {
+        while ((std::size_t(1) << _bits) < std::size_t(n) * 2) ++_bits; // 装填因子不超过 1/2
+        _slot.assign(std::size_t(1) << _bits, -1);
+    }
+    std::size_t capacity() const { return _slot.size(); }
+    Rank count() const { return _count; }
+    // Fibonacci 散列：std::hash 对整数常为恒等映射，须再打散
+    std::size_t home(std::size_t h) const {
+        return static_cast<std::size_t>((std::uint64_t(h) * 0x9E3779B97F4A7C15ull) >> (64 - _bits));
+    }
+    // 在 A 中查找与 e 相等的已登记元素；不存在时登记 r。返回该元素的秩(新登记时即 r)
+    template <typename T>
+    Rank findOrInsert(T const* A, T const& e, std::size_t h, Rank r) {
+        std::size_t mask = _slot.size() - 1;
+        for (std::size_t i = home(h); ; i = (i + 1) & mask) {
+            if (_slot[i] < 0) { _slot[i] = r; ++_count; return r; }
+            if (!(A[_slot[i]] != e)) return _slot[i];
+        }
+    }
+};
+
+// 去重 A[0, n)：保留的元素依次移至前缀，返回其数目，期望 O(n)
+template <typename T>
+Rank deduplicate(T* A, Rank n) {
+    if (n < 2) return n;
+    std::hash<T> hash;
+    RankTable table(n);
+    Rank j = 0; // A[0, j) 为已保留的元素
+    for (Rank i = 0; i < n; ++i)
+        if (table.findOrInsert(A, A[i], hash(A[i]), j) == j) {
+            if (i != j) A[j] = std::move(A[i]);
+            ++j;
+        }
+    return j;
+}
+
+// 有限内存的去重：散列表至多约 budget 项
+// 按散列值将元素分为若干组，每趟只登记一组，重复者记入位图；最后一趟统一压缩
+// 额外空间为 n 个比特加 O(budget)，时间 O(n * n / budget)
+template <typename T>
+Rank deduplicate(T* A, Rank n, Rank budget) {
+    if (budget <= 0 || n <= budget) return deduplicate(A, n);
+    std::hash<T> hash;
+    std::size_t passes = (std::size_t(n) + budget - 1) / budget;
+    std::vector<bool> dup(n, false);
+    for (std::size_t p = 0; p < passes; ++p) {
+        RankTable table(budget);
+        for (Rank i = 0; i < n; ++i) {
+            std::size_t h = hash(A[i]);
+            if (h % passes != p) continue;
+            if (table.count() * 4 >= Rank(table.capacity()) * 3) { // 分组不均时扩容，避免表满
+                RankTable larger(Rank(table.capacity()));
+                for (Rank k = 0; k < i; ++k) {
+                    std::size_t hk = hash(A[k]);
+                    if (hk % passes == p && !dup[k]) larger.findOrInsert(A, A[k], hk, k);
+                }
+                table = std::move(larger);
+            }
+            if (table.findOrInsert(A, A[i], h, i) != i) dup[i] = true;
+        }
+    }
+    Rank j = 0;
+    for (Rank i = 0; i < n; ++i)
+        if (!dup[i]) {
+            if (i != j) A[j] = std::move(A[i]);
+            ++j;
+        }
+    return j;
+}
+
+} // namespace dsa
+
+#endif // DEDUP_H
@@ -0,0 +1,130 @@
+// MappedVector 的往返校验：新建、插入(多次扩容)、落盘、重新打开、排序、查找，
+// 每一步都与 std::vector 上的同样操作比较；另以稀疏文件检查超过 INT_MAX 个元素的文件被拒绝
+// 全部一致时返回 0，否则打印第一处不一致并返回 1
+//
+// 用法：mapped_vector_demo [--n N] [--path 文件]
+
+#include <algorithm> // std::sort, std::upper_bound
+#include <cstdint>   // std::uint32_t
+#include <cstdio>    // std::printf, std::fprintf, std::remove
+#include <cstdlib>   // std::atoll
+#include <cstring>   // std::strcmp
+#include <stdexcept> // std::runtime_error
+#include <vector>    // std::vector
+#include <fcntl.h>   // open
+#include <sys/stat.h> // stat
+#include <unistd.h>  // ftruncate, close
+#include "MappedVector.h"
+#include "Random.h"
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, char const* what) {
+    std::printf("%-40s %s\n", what, ok ? "ok" : "FAILED");
+    if (!ok) ++failures;
+}
+
+bool same(MappedVector<int> const& v, std::vector<int> const& ref) {
+    if (v.size() != static_cast<Rank>(ref.size())) return false;
+    for (Rank i = 0; i < v.size(); ++i)
+        if (v.data()[i] != ref[i]) return false;
+    return true;
+}
+
+long long fileBytes(char const* path) {
+    struct stat st;
+    return ::stat(path, &st) == 0 ? static_cast<long long>(st.st_size) : -1;
+}
+
+// 文件头声称的元素数不大，但文件长度(稀疏，不占磁盘)容得下 INT_MAX + 1 个元素：打开时须拒绝
+void checkOversized(char const* path) {
+    std::remove(path);
+    { MappedVector<char> v(path); } // 写出合法的文件头
+    int fd = ::open(path, O_RDWR);
+    bool rejected = false;
+    if (fd >= 0 && ::ftruncate(fd, static_cast<off_t>(64 + (1LL << 31))) == 0) {
+        ::close(fd);
+        try {
+            MappedVector<char> v(path, true);
+        } catch (std::runtime_error const&) {
+            rejected = true;
+        }
+    } else if (fd >= 0) {
+        ::close(fd);
+    }
+    check(rejected, "reject file with > INT_MAX elements");
+    std::remove(path);
+}
+
+long long argValue(int argc, char** argv, char const* name, long long fallback) {
+    for (int i = 1; i + 1 < argc; ++i)
+        if (!std::strcmp(argv[i], name)) return std::atoll(argv[i + 1]);
+    return fallback;
+}
+
+char const* argString(int argc, char** argv, char const* name, char const* fallback) {
+    for (int i = 1; i + 1 < argc; ++i)
+        if (!std::strcmp(argv[i], name)) return argv[i + 1];
+    return fallback;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Rank n = static_cast<Rank>(argValue(argc, argv, "--n", 1000000));
+    char const* path = argString(argc, argv, "--path", "mapped_vector_demo.bin");
+    dsa::Random rng(2024);
+    std::vector<int> ref;
+    std::remove(path);
+
+    try {
+        { // 新建并插入：新文件只有 4KB，插入过程中文件反复加倍、重新映射
+            MappedVector<int> v(path);
+            for (Rank i = 0; i < n; ++i) {
+                int e = static_cast<int>(rng.below(0x7FFFFFFF));
+                if (i % 1000 == 0) { // 偶尔在中间插入，走 memmove 路径
+                    Rank r = static_cast<Rank>(rng.below(static_cast<std::uint32_t>(ref.size() + 1)));
+                    v.insert(r, e);
+                    ref.insert(ref.begin() + r, e);
+                } else {
+                    v.insert(e);
+                    ref.push_back(e);
+                }
+            }
+            check(same(v, ref), "insert (grow and remap)");
+            check(v.capacity() >= v.size(), "capacity covers size");
+            v.flush();
+        } // 关闭时截去多余的容量
+        check(fileBytes(path) == 64 + static_cast<long long>(sizeof(int)) * n, "file trimmed to header + data");
+
+        { // 重新打开、排序、查找
+            MappedVector<int> v(path);
+            check(same(v, ref), "reopen");
+            v.sort();
+            std::sort(ref.begin(), ref.end());
+            check(v.disordered() == 0 && same(v, ref), "sort");
+            bool found = true;
+            for (int k = 0; k < 10000 && n > 0; ++k) {
+                int e = k & 1 ? ref[rng.below(static_cast<std::uint32_t>(ref.size()))] : static_cast<int>(rng.below(0x7FFFFFFF));
+                Rank expect = static_cast<Rank>(std::upper_bound(ref.begin(), ref.end(), e) - ref.begin()) - 1;
+                if (v.search(e) != expect) found = false;
+            }
+            check(found, "search");
+            v.flush();
+        }
+
+        { // 只读打开：排序结果已落盘
+            MappedVector<int> v(path, true);
+            check(same(v, ref), "reopen read-only after sort");
+        }
+        std::remove(path);
+        checkOversized(path);
+    } catch (std::exception const& e) {
+        std::fprintf(stderr, "error: %s\n", e.what());
+        std::remove(path);
+        return 1;
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,252 @@
+#ifndef MAPPEDVECTOR_H
+#define MAPPEDVECTOR_H
+
+#ifdef _WIN32
+#error "MappedVector.h requires POSIX mmap (use CreateFileMapping on Windows)"
+#endif
+
+#include <cerrno>       // errno
+#include <cstdint>      // std::uint32_t, std::uint64_t
+#include <cstring>      // std::memcpy, std::memmove, std::memcmp
+#include <limits>       // std::numeric_limits
+#include <stdexcept>    // std::out_of_range, std::runtime_error, std::logic_error, std::length_error
+#include <system_error> // std::system_error
+#include <type_traits>  // std::is_trivially_copyable
+#include <fcntl.h>      // open
+#include <sys/mman.h>   // mmap, munmap, msync
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // ftruncate, close
+#include "Sort.h"       // introSort
+#include "Simd.h"       // 向量化查找与判序
+#include "Search.h"     // 无分支查找与静态查找索引
+
+typedef int Rank; // 秩
+
+// 以内存映射文件为数据区的持久化向量，仅适用于平凡可复制类型：
+// 打开时只建立映射，不读入、不复制数据；排序、查找等直接作用于映射区，
+// 修改由内核写回文件，flush() 可强制同步落盘
+//
+// 文件格式：64 字节的文件头(魔数、元素大小、规模)之后紧接元素数组，
+// 数组之后可能留有尚未使用的容量，关闭时截去
+// 秩为 int，元素数(连同容量)至多 MAX_SIZE = INT_MAX 个：打开更大的文件抛出 std::runtime_error，
+// 插入超出时抛出 std::length_error，而不是让秩溢出
+template <typename T>
+class MappedVector {
+    static_assert(std::is_trivially_copyable<T>::value, "MappedVector requires a trivially copyable T");
+    static_assert(alignof(T) <= 64, "MappedVector requires alignof(T) <= 64");
+
+    struct Header {
+        char magic[8];          // "DSAVEC01"
+        std::uint32_t elemSize; // sizeof(T)，打开时校验
+        std::uint32_t reserved;
+        std::uint64_t size;     // 规模
+    };
+    static constexpr std::size_t HEADER_BYTES = 64; // 文件头所占字节数(保证数据区对齐)
+    static constexpr std::size_t MIN_BYTES = 4096;  // 新建文件的最小长度
+    static constexpr Rank MAX_SIZE = std::numeric_limits<Rank>::max(); // 元素数的上限
+
+    int _fd;           // 文件描述符
+    bool _readOnly;    // 是否只读打开(映射为写时复制，修改不写回文件)
+    char* _map;        // 映射区起点(即文件头)
+    std::size_t _bytes; // 映射区(即文件)的长度
+    Rank _size;        // 规模
+    Rank _capacity;    // 容量
+    T* _elem;          // 数据区
+
+    Header* header() const { return reinterpret_cast<Header*>(_map); }
+
+    [[noreturn]] static void fail(char const* what) { throw std::system_error(errno, std::generic_category(), what); }
+
+    // 按当前文件长度重新建立映射
+    void map() {
+        void* p = ::mmap(nullptr, _bytes, PROT_READ | PROT_WRITE, _readOnly ? MAP_PRIVATE : MAP_SHARED, _fd, 0);
+        if (p == MAP_FAILED) fail("MappedVector: mmap");
+        _map = static_cast<char*>(p);
+        _elem = reinterpret_cast<T*>(_map + HEADER_BYTES);
+        std::size_t capacity = (_bytes - HEADER_BYTES) / sizeof(T);
+        if (capacity > static_cast<std::size_t>(MAX_SIZE)) {
+            unmap();
+            throw std::runtime_error("MappedVector: file holds more than INT_MAX elements");
+        }
+        _capacity = static_cast<Rank>(capacity);
+    }
+
+    void unmap() {
+        if (_map) ::munmap(_map, _bytes);
+        _map = nullptr;
+        _elem = nullptr;
+    }
+
+    void writable() const {
+        if (_readOnly) throw std::logic_error("MappedVector: opened read-only");
+    }
+
+    // 文件扩展至可容纳 n 个元素，并重新映射
+    void resizeFile(Rank n) {
+        std::size_t bytes = HEADER_BYTES + sizeof(T) * static_cast<std::size_t>(n);
+        if (::ftruncate(_fd, static_cast<off_t>(bytes)) != 0) fail("MappedVector: ftruncate");
+        unmap();
+        _bytes = bytes;
+        map();
+    }
+
+    // 空间不足时容量加倍(文件随之增长)，至多 MAX_SIZE
+    void expand(Rank k = 1) {
+        long long need = static_cast<long long>(_size) + k;
+        if (need <= _capacity) return;
+        if (need > MAX_SIZE) throw std::length_error("MappedVector: more than INT_MAX elements");
+        long long c = _capacity < 1 ? 1 : _capacity;
+        while (c < need) c <<= 1;
+        resizeFile(static_cast<Rank>(c < MAX_SIZE ? c : MAX_SIZE));
+    }
+
+public:
+    // 打开 path(不存在时新建)；readOnly 时文件须已存在，规模不可改变，
+    // 排序等原地修改只作用于进程私有的副本页
+    explicit MappedVector(char const* path, bool readOnly = false)
+        : _fd(-1), _readOnly(readOnly), _map(nullptr), _bytes(0), _size(0), _capacity(0), _elem(nullptr) {
+        _fd = readOnly ? ::open(path, O_RDONLY) : ::open(path, O_RDWR | O_CREAT, 0644);
+        if (_fd < 0) fail("MappedVector: open");
+        try {
+            struct stat st;
+            if (::fstat(_fd, &st) != 0) fail("MappedVector: fstat");
+            if (st.st_size == 0) { // 新文件：写入文件头
+                writable();
+                if (::ftruncate(_fd, MIN_BYTES) != 0) fail("MappedVector: ftruncate");
+                _bytes = MIN_BYTES;
+                map();
+                Header* h = header();
+                std::memcpy(h->magic, "DSAVEC01", 8);
+                h->elemSize = sizeof(T);
+                h->reserved = 0;
+                h->size = 0;
+            } else {
+                _bytes = static_cast<std::size_t>(st.st_size);
+                if (_bytes < HEADER_BYTES) throw std::runtime_error("MappedVector: file too short");
+                map();
+                Header const* h = header();
+                if (std::memcmp(h->magic, "DSAVEC01", 8) != 0 || h->elemSize != sizeof(T))
+                    throw std::runtime_error("MappedVector: bad header or element size");
+                if (h->size > static_cast<std::uint64_t>(_capacity))
+                    throw std::runtime_error("MappedVector: file truncated");
+                _size = static_cast<Rank>(h->size);
+            }
+        } catch (...) {
+            unmap();
+            ::close(_fd);
+            throw;
+        }
+    }
+
+    // 关闭：截去未使用的容量(下次打开时文件恰为文件头加数据)
+    ~MappedVector() {
+        unmap();
+        if (!_readOnly)
+            (void)::ftruncate(_fd, static_cast<off_t>(HEADER_BYTES + sizeof(T) * static_cast<std::size_t>(_size)));
+        ::close(_fd);
+    }
+
+    MappedVector(MappedVector const&) = delete;
+    MappedVector& operator=(MappedVector const&) = delete;
+
+    // 只读访问接口
+    Rank size() const { return _size; } // 规模
+    bool empty() const { return !_size; } // 判空
+    Rank capacity() const { return _capacity; } // 容量
+    T const* data() const { return _elem; } // 数据区(映射区内)
+
+    // 判断向量是否已排序
+    int disordered() const {
+        if constexpr (dsa::simd::Supported<T>::value) return dsa::simd::countDescents(_elem, _size);
+        int n = 0;
+        for (Rank i = 1; i < _size; ++i)
+            if (_elem[i-1] > _elem[i]) ++n;
+        return n;
+    }
+
+    // 无序向量查找
+    Rank find(T const& e) const { return find(e, 0, _size); }
+    Rank find(T const& e, Rank lo, Rank hi) const {
+        if constexpr (dsa::simd::Supported<T>::value) return dsa::simd::findLast(_elem, lo, hi, e);
+        while ((lo < hi--) && (e != _elem[hi]));
+        return hi;
+    }
+
+    // 有序向量查找
+    Rank search(T const& e) const { return (_size > 0) ? search(e, 0, _size) : -1; }
+    Rank search(T const& e, Rank lo, Rank hi) const { return dsa::search(_elem, lo, hi, e); }
+    dsa::SearchIndex<T> buildIndex() const { return dsa::SearchIndex<T>(_elem, _size); } // 静态查找索引
+
+    // 可写访问接口
+    T& operator[](Rank r) const {
+        if (r < 0 || r >= _size)
+            throw std::out_of_range("MappedVector index out of range");
+        return _elem[r];
+    }
+
+    // 预留空间，使容量至少为 n
+    void reserve(Rank n) {
+        writable();
+        if (n > _capacity) resizeFile(n);
+    }
+
+    // 在秩 r 处插入元素
+    Rank insert(Rank r, T const& e) {
+        writable();
+        if (r < 0 || r > _size)
+            throw std::out_of_range("insert: invalid rank");
+        T copy = e; // e 可能位于映射区内，扩容后失效
+        expand();
+        std::memmove(static_cast<void*>(_elem + r + 1), _elem + r, sizeof(T) * (_size - r));
+        _elem[r] = copy;
+        header()->size = ++_size;
+        return r;
+    }
+    Rank insert(T const& e) { return insert(_size, e); } // 默认作为末元素插入
+
+    // 在末尾追加 A[0, n)(A 不得取自本向量)
+    void append(T const* A, Rank n) {
+        writable();
+        if (n <= 0) return;
+        expand(n);
+        std::memcpy(static_cast<void*>(_elem + _size), A, sizeof(T) * n);
+        header()->size = _size += n;
+    }
+
+    // 删除秩在区间 [lo, hi) 之内的元素(文件不收缩)
+    int remove(Rank lo, Rank hi) {
+        writable();
+        if (lo < 0 || hi > _size || lo > hi)
+            throw std::out_of_range("remove: invalid lo or hi");
+        std::memmove(static_cast<void*>(_elem + lo), _elem + hi, sizeof(T) * (_size - hi));
+        header()->size = _size -= hi - lo;
+        return hi - lo;
+    }
+    T remove(Rank r) { // 删除秩为 r 的元素
+        T e = (*this)[r];
+        remove(r, r + 1);
+        return e;
+    }
+
+    // 对 [lo, hi) 就地做内省排序，除 O(log n) 的栈外不占额外内存
+    // 不用基数排序：它要在堆上复制整段数据，而映射的文件往往比物理内存还大
+    void sort(Rank lo, Rank hi) { dsa::introSort(_elem, lo, hi); }
+    void sort() { sort(0, _size); } // 整体排序
+
+    // 遍历
+    void traverse(void (*visit)(T&)) {
+        for (Rank i = 0; i < _size; ++i) visit(_elem[i]);
+    }
+    template <typename VST>
+    void traverse(VST& visit) {
+        for (Rank i = 0; i < _size; ++i) visit(_elem[i]);
+    }
+
+    // 将映射区中的修改同步写入文件(阻塞至落盘)
+    void flush() {
+        if (_readOnly) return;
+        if (::msync(_map, _bytes, MS_SYNC) != 0) fail("MappedVector: msync");
+    }
+}; // MappedVector
+
+#endif // MAPPEDVECTOR_H
@@ -0,0 +1,144 @@
+#ifndef MERGESORT_H
+#define MERGESORT_H
+
+#include <algorithm>   // std::min, std::max, std::swap
+#include <cstdlib>     // std::malloc, std::free
+#include <memory>      // std::uninitialized_move
+#include <new>         // std::bad_alloc
+#include <thread>      // std::thread::hardware_concurrency
+#include <type_traits> // std::is_trivially_copyable
+#include <utility>     // std::move
+#include <vector>      // std::vector
+#include "Sort.h"      // insertionSort
+#include "Parallel.h"  // ThreadPool
+
+// 稳定的自底向上归并排序：整个排序只分配一次辅助空间，可多线程并行
+namespace dsa {
+
+const Rank MERGE_RUN = 32;             // 初始有序段长度(由插入排序生成)
+const Rank PARALLEL_MIN_CHUNK = 1 << 14; // 每个线程至少分得的元素数
+
+// 归并排序的辅助空间：n 个元素，整个排序过程中只分配一次
+template <typename T>
+class MergeBuffer {
+    T* _p;
+    Rank _n;
+    bool _constructed; // 非平凡类型的元素是否已构造
+public:
+    explicit MergeBuffer(Rank n) : _p(static_cast<T*>(std::malloc(sizeof(T) * (n ? n : 1)))), _n(n), _constructed(false) {
+        if (!_p) throw std::bad_alloc();
+    }
+    ~MergeBuffer() {
+        if (_constructed)
+            for (Rank i = 0; i < _n; ++i) _p[i].~T();
+        std::free(_p);
+    }
+    MergeBuffer(MergeBuffer const&) = delete;
+    MergeBuffer& operator=(MergeBuffer const&) = delete;
+
+    T* data() { return _p; }
+    // 将 A[0, n) 移入本缓冲区，此后双方元素均处于已构造状态，可相互移动赋值
+    void moveFrom(T* A) {
+        std::uninitialized_move(A, A + _n, _p);
+        _constructed = true;
+    }
+};
+
+// 将有序段 [a, aEnd) 与 [b, bEnd) 归并至 out，相等时前者优先(稳定)
+template <typename T>
+void mergeRuns(T* a, T* aEnd, T* b, T* bEnd, T* out) {
+    while (a < aEnd && b < bEnd)
+        *out++ = (*b < *a) ? std::move(*b++) : std::move(*a++);
+    while (a < aEnd) *out++ = std::move(*a++);
+    while (b < bEnd) *out++ = std::move(*b++);
+}
+
+// 归并路径划分：a[0, la) 与 b[0, lb) 归并结果的前 d 个元素中，来自 a 的个数
+template <typename T>
+Rank mergePath(T const* a, Rank la, T const* b, Rank lb, Rank d) {
+    Rank lo = std::max<Rank>(0, d - lb), hi = std::min(d, la);
+    while (lo < hi) {
+        Rank i = lo + (hi - lo) / 2;
+        if (b[d - i - 1] < a[i]) hi = i;
+        else lo = i + 1;
+    }
+    return lo;
+}
+
+// 将 src[lo, mi) 与 src[mi, hi) 归并结果中的第 [d0, d1) 个元素写入 dst[lo + d0, lo + d1)
+template <typename T>
+void mergeSegment(T* src, Rank lo, Rank mi, Rank hi, T* dst, Rank d0, Rank d1) {
+    Rank la = mi - lo, lb = hi - mi;
+    Rank i0 = mergePath(src + lo, la, src + mi, lb, d0);
+    Rank i1 = mergePath(src + lo, la, src + mi, lb, d1);
+    mergeRuns(src + lo + i0, src + lo + i1, src + mi + (d0 - i0), src + mi + (d1 - i1), dst + lo + d0);
+}
+
+// 在 A[lo, hi) 上自底向上归并排序，B 为同址的辅助空间；结果留在 A 中
+template <typename T>
+void bottomUpSort(T* A, T* B, Rank lo, Rank hi) {
+    for (Rank r = lo; r < hi; r += MERGE_RUN)
+        insertionSort(A, r, std::min(r + MERGE_RUN, hi));
+    T* src = A;
+    T* dst = B;
+    for (Rank w = MERGE_RUN; w < hi - lo; w <<= 1) {
+        for (Rank p = lo; p < hi; p += w << 1) {
+            Rank mi = std::min(p + w, hi), q = std::min(p + (w << 1), hi);
+            mergeRuns(src + p, src + mi, src + mi, src + q, dst + p);
+        }
+        std::swap(src, dst);
+    }
+    if (src != A)
+        for (Rank i = lo; i < hi; ++i) A[i] = std::move(src[i]);
+}
+
+// 稳定排序 A[lo, hi)：threads 为并行度，不大于 0 时取硬件并发数；任务由全局线程池执行
+// 各线程先独立排序一段，再逐层两两归并；每层的归并按归并路径均分给所有线程
+template <typename T>
+void mergeSort(T* A, Rank lo, Rank hi, int threads = 1) {
+    Rank n = hi - lo;
+    if (n < 2) return;
+    A += lo;
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    int P = static_cast<int>(std::min<Rank>(threads, std::max<Rank>(1, n / PARALLEL_MIN_CHUNK)));
+
+    MergeBuffer<T> buffer(n);
+    T* S = A;              // 排序在 S 中进行
+    T* D = buffer.data();  // D 为乒乓缓冲
+    if (!std::is_trivially_copyable<T>::value) { // 非平凡类型须先构造缓冲区中的元素
+        buffer.moveFrom(A);
+        std::swap(S, D);
+    }
+
+    std::vector<Rank> bound(P + 1); // 各有序段的边界
+    for (int k = 0; k <= P; ++k) bound[k] = static_cast<Rank>(static_cast<long long>(n) * k / P);
+    ThreadPool& pool = ThreadPool::instance();
+    pool.run(P, [&](int k) { bottomUpSort(S, D, bound[k], bound[k + 1]); });
+
+    T* src = S;
+    T* dst = D;
+    while (bound.size() > 2) {
+        Rank m = static_cast<Rank>(bound.size()) - 1; // 有序段数
+        pool.run(P, [&](int k) {
+            Rank s = static_cast<Rank>(static_cast<long long>(n) * k / P);
+            Rank e = static_cast<Rank>(static_cast<long long>(n) * (k + 1) / P);
+            for (Rank p = 0; p < m; p += 2) {
+                Rank plo = bound[p], pmi = bound[std::min(p + 1, m)], phi = bound[std::min(p + 2, m)];
+                if (phi <= s) continue;
+                if (plo >= e) break;
+                mergeSegment(src, plo, pmi, phi, dst, std::max(s, plo) - plo, std::min(e, phi) - plo);
+            }
+        });
+        std::vector<Rank> next;
+        for (Rank p = 0; p < m; p += 2) next.push_back(bound[p]);
+        next.push_back(bound[m]);
+        bound.swap(next);
+        std::swap(src, dst);
+    }
+    if (src != A)
+        for (Rank i = 0; i < n; ++i) A[i] = std::move(src[i]);
+}
+
+} // namespace dsa
+
+#endif // MERGESORT_H
@@ -0,0 +1,276 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>          // std::max, std::min
+#include <atomic>             // std::atomic
+#include <condition_variable> // std::condition_variable
+#include <deque>              // std::deque
+#include <exception>          // std::exception_ptr
+#include <functional>         // std::function
+#include <memory>             // std::shared_ptr
+#include <mutex>              // std::mutex
+#include <thread>             // std::thread
+#include <type_traits>        // std::is_same
+#include <utility>            // std::move
+#include <vector>             // std::vector
+
+typedef int Rank; // 秩
+
+#if defined(__GNUC__) && !defined(__clang__)
+#define DSA_IVDEP _Pragma("GCC ivdep")
+#elif defined(__clang__)
+#define DSA_IVDEP _Pragma("clang loop vectorize(enable)")
+#else
+#define DSA_IVDEP
+#endif
+
+namespace dsa {
+
+// 执行策略：顺序、线程池上分块并行、允许向量化(迭代之间无依赖)
+struct SequencedPolicy {};
+struct ParallelPolicy {
+    Rank grain; // 每块的元素数，0 表示按线程数自动划分
+};
+struct UnsequencedPolicy {};
+
+const SequencedPolicy seq = {};
+const ParallelPolicy par = {0};
+const UnsequencedPolicy unseq = {};
+
+// 可复用的线程池：工作线程常驻，run() 以 fork-join 方式执行一批任务，
+// 调用者线程也参与执行，因此在任务中嵌套调用 run() 不会死锁
+class ThreadPool {
+    struct Job { // 一批任务的共享状态，由参与者共同持有
+        std::function<void(int)> task;
+        int count;
+        std::atomic<int> next{0};
+        std::atomic<int> done{0};
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+
+    std::vector<std::thread> _workers;
+    std::deque<std::function<void()>> _queue;
+    std::mutex _mutex;
+    std::condition_variable _ready;
+    bool _stop;
+
+    // 领取并执行 job 中尚未开始的任务，直至全部领完
+    static void work(Job& job) {
+        int k;
+        while ((k = job.next.fetch_add(1)) < job.count) {
+            try {
+                job.task(k);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(job.mutex);
+                if (!job.error) job.error = std::current_exception();
+            }
+            if (job.done.fetch_add(1) + 1 == job.count) {
+                std::lock_guard<std::mutex> lock(job.mutex);
+                job.finished.notify_all();
+            }
+        }
+    }
+
+    void loop() {
+        for (;;) {
+            std::function<void()> f;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _ready.wait(lock, [this] { return _stop || !_queue.empty(); });
+                if (_queue.empty()) return;
+                f = std::move(_queue.front());
+                _queue.pop_front();
+            }
+            f();
+        }
+    }
+
+public:
+    // 工作线程数默认为硬件并发数减一(调用者线程亦参与计算)
+    explicit ThreadPool(unsigned workers = std::max(1u, std::thread::hardware_concurrency()) - 1) : _stop(false) {
+        for (unsigned i = 0; i < workers; ++i)
+            _workers.emplace_back([this] { loop(); });
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _ready.notify_all();
+        for (std::thread& t : _workers) t.join();
+    }
+
+    ThreadPool(ThreadPool const&) = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+
+    // 参与计算的线程数(含调用者)
+    int concurrency() const { return static_cast<int>(_workers.size()) + 1; }
+
+    // 执行 f(0) ... f(count - 1) 并等待全部完成；任一任务抛出的异常在此重新抛出
+    template <typename F>
+    void run(int count, F const& f) {
+        if (count <= 0) return;
+        if (count == 1 || _workers.empty()) {
+            for (int k = 0; k < count; ++k) f(k);
+            return;
+        }
+        std::shared_ptr<Job> job = std::make_shared<Job>();
+        job->task = [&f](int k) { f(k); };
+        job->count = count;
+        int helpers = std::min<int>(count - 1, static_cast<int>(_workers.size()));
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (int i = 0; i < helpers; ++i)
+                _queue.emplace_back([job] { work(*job); });
+        }
+        _ready.notify_all();
+        work(*job);
+        {
+            std::unique_lock<std::mutex> lock(job->mutex);
+            job->finished.wait(lock, [&] { return job->done.load() == count; });
+        }
+        if (job->error) std::rethrow_exception(job->error);
+    }
+
+    // 将 [0, n) 划分为每块 grain 个元素(0 表示自动)，并行执行 f(lo, hi)
+    template <typename F>
+    void parallelFor(Rank n, Rank grain, F const& f) {
+        if (n <= 0) return;
+        if (grain <= 0) grain = std::max<Rank>(1024, n / (4 * concurrency()));
+        int chunks = static_cast<int>((static_cast<long long>(n) + grain - 1) / grain);
+        run(chunks, [&](int k) {
+            Rank lo = static_cast<Rank>(static_cast<long long>(k) * grain);
+            f(lo, std::min<Rank>(n, lo + grain));
+        });
+    }
+
+    // 全局共享的线程池
+    static ThreadPool& instance() {
+        static ThreadPool pool;
+        return pool;
+    }
+};
+
+// 对 A[0, n) 中的每个元素执行 visit
+template <typename T, typename F>
+void forEach(SequencedPolicy, T* A, Rank n, F&& visit) {
+    for (Rank i = 0; i < n; ++i) visit(A[i]);
+}
+
+template <typename T, typename F>
+void forEach(UnsequencedPolicy, T* A, Rank n, F&& visit) {
+    DSA_IVDEP
+    for (Rank i = 0; i < n; ++i) visit(A[i]);
+}
+
+template <typename T, typename F>
+void forEach(ParallelPolicy policy, T* A, Rank n, F&& visit) {
+    ThreadPool::instance().parallelFor(n, policy.grain, [&](Rank lo, Rank hi) {
+        for (Rank i = lo; i < hi; ++i) visit(A[i]);
+    });
+}
+
+// A[i] = f(A[i])
+template <typename Policy, typename T, typename F>
+void transform(Policy policy, T* A, Rank n, F&& f) {
+    forEach(policy, A, n, [&f](T& e) { e = f(e); });
+}
+
+// 满足 pred 的元素数
+template <typename T, typename Pred>
+Rank countIf(SequencedPolicy, T const* A, Rank n, Pred&& pred) {
+    Rank cnt = 0;
+    for (Rank i = 0; i < n; ++i)
+        if (pred(A[i])) ++cnt;
+    return cnt;
+}
+
+template <typename T, typename Pred>
+Rank countIf(UnsequencedPolicy, T const* A, Rank n, Pred&& pred) {
+    Rank cnt = 0;
+    DSA_IVDEP
+    for (Rank i = 0; i < n; ++i)
+        cnt += pred(A[i]) ? 1 : 0;
+    return cnt;
+}
+
+template <typename T, typename Pred>
+Rank countIf(ParallelPolicy policy, T const* A, Rank n, Pred&& pred) {
+    std::atomic<Rank> total(0);
+    ThreadPool::instance().parallelFor(n, policy.grain, [&](Rank lo, Rank hi) {
+        total += countIf(unseq, A + lo, hi - lo, pred);
+    });
+    return total.load();
+}
+
+// 归约 init op A[0] op A[1] op ...
+// 不带 combine 时 op 须是 T 上满足结合律的二元运算(R 即 T，如 +、max)：并行时各块自其首元素起算，
+// 块结果再以 op 按块序合并。累积值与元素类型不同的运算(如把 int 累加为 long long、计数)须用带 combine 的形式
+template <typename T, typename R, typename Op>
+R reduce(SequencedPolicy, T const* A, Rank n, R init, Op&& op) {
+    for (Rank i = 0; i < n; ++i) init = op(init, A[i]);
+    return init;
+}
+
+template <typename T, typename R, typename Op>
+R reduce(UnsequencedPolicy, T const* A, Rank n, R init, Op&& op) {
+    return reduce(seq, A, n, init, op);
+}
+
+template <typename T, typename R, typename Op>
+R reduce(ParallelPolicy policy, T const* A, Rank n, R init, Op&& op) {
+    static_assert(std::is_same<R, T>::value, "parallel reduce without combine requires R == T; pass a combine (R, R) -> R");
+    ThreadPool& pool = ThreadPool::instance();
+    Rank grain = policy.grain > 0 ? policy.grain : std::max<Rank>(1024, n / (4 * pool.concurrency()));
+    if (n <= grain) return reduce(seq, A, n, init, op);
+    int chunks = static_cast<int>((static_cast<long long>(n) + grain - 1) / grain);
+    std::vector<R> partial(chunks, init);
+    pool.run(chunks, [&](int k) {
+        Rank lo = static_cast<Rank>(static_cast<long long>(k) * grain);
+        Rank hi = std::min<Rank>(n, lo + grain);
+        R acc = A[lo];
+        for (Rank i = lo + 1; i < hi; ++i) acc = op(acc, A[i]);
+        partial[k] = acc;
+    });
+    for (int k = 0; k < chunks; ++k) init = op(init, partial[k]);
+    return init;
+}
+
+// 带 combine 的归约：op(R, T) -> R 将元素并入累积值，combine(R, R) -> R 合并相邻两段的累积值。
+// 并行时首块自 init 起算，其余各块自 R() 起算，块结果以 combine 按块序合并；
+// 因此 R() 须是 combine 的单位元，且 combine(r, 某段自 R() 起的累积) 等于 r 继续累积该段(如 op 计数、combine 相加)
+template <typename T, typename R, typename Op, typename Combine>
+R reduce(SequencedPolicy, T const* A, Rank n, R init, Op&& op, Combine&&) {
+    return reduce(seq, A, n, init, op);
+}
+
+template <typename T, typename R, typename Op, typename Combine>
+R reduce(UnsequencedPolicy, T const* A, Rank n, R init, Op&& op, Combine&&) {
+    return reduce(seq, A, n, init, op);
+}
+
+template <typename T, typename R, typename Op, typename Combine>
+R reduce(ParallelPolicy policy, T const* A, Rank n, R init, Op&& op, Combine&& combine) {
+    ThreadPool& pool = ThreadPool::instance();
+    Rank grain = policy.grain > 0 ? policy.grain : std::max<Rank>(1024, n / (4 * pool.concurrency()));
+    if (n <= grain) return reduce(seq, A, n, init, op);
+    int chunks = static_cast<int>((static_cast<long long>(n) + grain - 1) / grain);
+    std::vector<R> partial(chunks, R());
+    pool.run(chunks, [&](int k) {
+        Rank lo = static_cast<Rank>(static_cast<long long>(k) * grain);
+        Rank hi = std::min<Rank>(n, lo + grain);
+        R acc = k == 0 ? init : R();
+        for (Rank i = lo; i < hi; ++i) acc = op(acc, A[i]);
+        partial[k] = acc;
+    });
+    R result = partial[0];
+    for (int k = 1; k < chunks; ++k) result = combine(result, partial[k]);
+    return result;
+}
+
+} // namespace dsa
+
+#endif // PARALLEL_H
@@ -0,0 +1,77 @@
+// 执行策略的一致性校验：同一批操作分别以 seq、unseq 与 par(自动分块及若干固定块长)执行，结果须与 seq 相同
+// 覆盖 T 上的结合运算(+、max)、累积值类型不同于元素的归约(计数、加宽求和)、count_if 与 transform
+// 全部一致时返回 0，否则打印不一致之处并返回 1
+//
+// 用法：policy_check [--n N]
+
+#include <algorithm> // std::max
+#include <cstdio>    // std::printf
+#include <cstdlib>   // std::atoll
+#include <cstring>   // std::strcmp
+#include "Vector.h"
+
+namespace {
+
+int failures = 0;
+
+template <typename R>
+void check(char const* what, Rank grain, R expect, R got) {
+    if (expect == got) return;
+    std::printf("%-28s grain=%-6d expect %lld, got %lld\n", what, grain, static_cast<long long>(expect), static_cast<long long>(got));
+    ++failures;
+}
+
+long long argValue(int argc, char** argv, char const* name, long long fallback) {
+    for (int i = 1; i + 1 < argc; ++i)
+        if (!std::strcmp(argv[i], name)) return std::atoll(argv[i + 1]);
+    return fallback;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Rank n = static_cast<Rank>(argValue(argc, argv, "--n", 100000));
+    Vector<int> v, big; // v 取值较小，求和不溢出；big 接近 INT_MAX，部分和一旦截为 int 即可察觉
+    dsa::Random rng(7);
+    for (Rank i = 0; i < n; ++i) {
+        v.insert(i % 7 == 3 ? 3 : static_cast<int>(rng.below(100)));
+        big.insert(0x7FFF0000 + static_cast<int>(rng.below(1000)));
+    }
+
+    auto plus = [](int a, int b) { return a + b; };                              // T 上的结合运算
+    auto maxOp = [](int a, int b) { return std::max(a, b); };
+    auto countThrees = [](int acc, int e) { return acc + (e == 3); };            // (R, T)：计数
+    auto widen = [](long long acc, int e) { return acc + e; };                   // (R, T)：加宽求和
+    auto addInt = [](int a, int b) { return a + b; };
+    auto addLong = [](long long a, long long b) { return a + b; };
+    auto odd = [](int e) { return (e & 1) != 0; };
+
+    int sumSeq = v.reduce(dsa::seq, 0, plus);
+    int maxSeq = v.reduce(dsa::seq, 0, maxOp);
+    int threesSeq = v.reduce(dsa::seq, 0, countThrees);
+    long long wideSeq = big.reduce(dsa::seq, 5LL, widen);
+    Rank oddSeq = v.count_if(dsa::seq, odd);
+    Vector<int> doubled(v);
+    doubled.transform(dsa::seq, [](int e) { return e * 2 + 1; });
+
+    check("unseq reduce count", 0, threesSeq, v.reduce(dsa::unseq, 0, countThrees, addInt));
+    check("unseq reduce widen", 0, wideSeq, big.reduce(dsa::unseq, 5LL, widen, addLong));
+    check("unseq count_if", 0, oddSeq, v.count_if(dsa::unseq, odd));
+
+    Rank const grains[] = {0, 1, 7, 1000, 65536};
+    for (Rank grain : grains) {
+        dsa::ParallelPolicy par = {grain};
+        check("par reduce +", grain, sumSeq, v.reduce(par, 0, plus));
+        check("par reduce max", grain, maxSeq, v.reduce(par, 0, maxOp));
+        check("par reduce count (R, T)", grain, threesSeq, v.reduce(par, 0, countThrees, addInt));
+        check("par reduce widen (R, T)", grain, wideSeq, big.reduce(par, 5LL, widen, addLong));
+        check("par count_if", grain, oddSeq, v.count_if(par, odd));
+        Vector<int> t(v);
+        t.transform(par, [](int e) { return e * 2 + 1; });
+        Rank diff = 0;
+        for (Rank i = 0; i < n; ++i) diff += t[i] != doubled[i];
+        check("par transform", grain, 0, diff);
+    }
+    std::printf("n=%d: %s\n", n, failures ? "FAILED" : "seq, unseq and par agree");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,81 @@
+#ifndef RADIXSORT_H
+#define RADIXSORT_H
+
+#include <cstddef>     // std::size_t
+#include <cstring>     // std::memcpy
+#include <limits>      // std::numeric_limits
+#include <memory>      // std::unique_ptr
+#include <type_traits> // std::is_integral, std::is_floating_point, std::make_unsigned
+#include "Sort.h"      // introSort
+
+typedef int Rank; // 秩
+
+// 整数与 IEEE 浮点数的 LSD 基数排序：每趟按一个字节分配，趟数等于字节数
+namespace dsa {
+
+const Rank RADIX_SORT_THRESHOLD = 256; // 规模不超过此值时仍用比较排序
+
+// T 能否按位模式做基数排序
+template <typename T>
+struct RadixSortable : std::integral_constant<bool,
+    (std::is_integral<T>::value && !std::is_same<T, bool>::value) ||
+    (std::is_floating_point<T>::value && std::numeric_limits<T>::is_iec559 && (sizeof(T) == 4 || sizeof(T) == 8))> {};
+
+// 与 T 同宽的无符号整数
+template <std::size_t N> struct UintOf;
+template <> struct UintOf<1> { typedef unsigned char type; };
+template <> struct UintOf<2> { typedef unsigned short type; };
+template <> struct UintOf<4> { typedef unsigned int type; };
+template <> struct UintOf<8> { typedef unsigned long long type; };
+
+// 将 e 映射为无符号排序键，使键的大小次序与 e 的大小次序一致
+// 有符号整数翻转符号位；浮点数的负数取反全部位，非负数置符号位
+template <typename T>
+typename UintOf<sizeof(T)>::type radixKey(T e) {
+    typedef typename UintOf<sizeof(T)>::type U;
+    const U sign = U(1) << (sizeof(T) * 8 - 1);
+    U u;
+    std::memcpy(&u, &e, sizeof(T));
+    if (std::is_floating_point<T>::value) return (u & sign) ? U(~u) : U(u | sign);
+    if (std::is_signed<T>::value) return U(u ^ sign);
+    return u;
+}
+
+// 基数排序 A[lo, hi)：一次统计所有字节的分布，所有元素在某字节上相同时略过该趟，
+// 只使用一个辅助数组乒乓往返
+template <typename T>
+void radixSort(T* A, Rank lo, Rank hi) {
+    const int BYTES = sizeof(T);
+    Rank n = hi - lo;
+    if (n <= RADIX_SORT_THRESHOLD) { introSort(A, lo, hi); return; }
+    A += lo;
+
+    std::size_t count[BYTES][256] = {};
+    for (Rank i = 0; i < n; ++i) {
+        typename UintOf<sizeof(T)>::type k = radixKey(A[i]);
+        for (int b = 0; b < BYTES; ++b)
+            ++count[b][(k >> (8 * b)) & 0xFF];
+    }
+
+    std::unique_ptr<T[]> buffer(new T[n]);
+    T* src = A;
+    T* dst = buffer.get();
+    for (int b = 0; b < BYTES; ++b) {
+        std::size_t* c = count[b];
+        if (c[(radixKey(A[0]) >> (8 * b)) & 0xFF] == std::size_t(n)) continue; // 该字节处处相同
+        std::size_t offset = 0;
+        for (int d = 0; d < 256; ++d) { // 计数转为各桶的起始位置
+            std::size_t t = c[d];
+            c[d] = offset;
+            offset += t;
+        }
+        for (Rank i = 0; i < n; ++i)
+            dst[c[(radixKey(src[i]) >> (8 * b)) & 0xFF]++] = src[i];
+        T* t = src; src = dst; dst = t;
+    }
+    if (src != A) std::memcpy(A, src, sizeof(T) * n);
+}
+
+} // namespace dsa
+
+#endif // RADIXSORT_H
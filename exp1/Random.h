@@ -0,0 +1,147 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <algorithm> // std::min, std::swap
+#include <cstdint>   // std::uint32_t, std::uint64_t
+#include <cstdlib>   // std::malloc, std::free
+#include <new>       // std::bad_alloc
+#include <random>    // std::random_device
+#include <type_traits> // std::is_trivially_copyable
+#include <utility>   // std::move
+#include <vector>    // std::vector
+#include "Parallel.h" // ThreadPool
+
+typedef int Rank; // 秩
+
+namespace dsa {
+
+// xoshiro256** 伪随机数发生器：可显式播种，状态仅 32 字节，
+// 满足 UniformRandomBitGenerator 要求，可直接用于标准库的分布
+class Random {
+    std::uint64_t _s[4];
+
+    static std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+    static std::uint64_t splitmix(std::uint64_t& x) { // 以 splitmix64 展开种子
+        std::uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+public:
+    typedef std::uint64_t result_type;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type(0); }
+
+    // 同一 (seed, stream) 总产生同一序列；不同 stream 用于并行时的独立子序列
+    explicit Random(std::uint64_t seed = 0, std::uint64_t stream = 0) { this->seed(seed, stream); }
+
+    void seed(std::uint64_t seed, std::uint64_t stream = 0) {
+        std::uint64_t x = seed ^ splitmix(stream);
+        for (int i = 0; i < 4; ++i) _s[i] = splitmix(x);
+    }
+
+    result_type operator()() {
+        std::uint64_t result = rotl(_s[1] * 5, 7) * 9;
+        std::uint64_t t = _s[1] << 17;
+        _s[2] ^= _s[0];
+        _s[3] ^= _s[1];
+        _s[1] ^= _s[2];
+        _s[0] ^= _s[3];
+        _s[2] ^= t;
+        _s[3] = rotl(_s[3], 45);
+        return result;
+    }
+
+    // [0, n) 中均匀分布的整数(n > 0)：Lemire 乘法取高位，拒绝少量样本以消除偏差
+    std::uint32_t below(std::uint32_t n) {
+        std::uint64_t m = ((*this)() >> 32) * n;
+        std::uint32_t l = static_cast<std::uint32_t>(m);
+        if (l < n) {
+            std::uint32_t t = static_cast<std::uint32_t>(-n) % n;
+            while (l < t) {
+                m = ((*this)() >> 32) * n;
+                l = static_cast<std::uint32_t>(m);
+            }
+        }
+        return static_cast<std::uint32_t>(m >> 32);
+    }
+
+    // [0, 1) 中均匀分布的实数
+    double uniform() { return ((*this)() >> 11) * (1.0 / 9007199254740992.0); }
+};
+
+// 当前线程的默认发生器：每个线程首次使用时以 std::random_device 播种一次
+inline Random& threadRandom() {
+    thread_local Random rng([] {
+        std::random_device device;
+        return (std::uint64_t(device()) << 32) ^ device();
+    }());
+    return rng;
+}
+
+// Fisher-Yates 置乱 A[lo, hi)
+template <typename T>
+void shuffle(T* A, Rank lo, Rank hi, Random& rng) {
+    for (Rank i = hi - 1; i > lo; --i)
+        std::swap(A[i], A[lo + rng.below(static_cast<std::uint32_t>(i - lo + 1))]);
+}
+
+const Rank SHUFFLE_CHUNK = 1 << 16;   // 并行置乱时每块的元素数
+const int SHUFFLE_MAX_BUCKETS = 1024; // 并行置乱的桶数上限
+
+// 并行置乱 A[0, n)：各元素独立地均匀落入某个桶，再对各桶分别做 Fisher-Yates，
+// 所得排列仍是均匀的。分块与分桶只取决于 n，故结果只由 seed 决定，与线程数无关
+template <typename T>
+void parallelShuffle(T* A, Rank n, std::uint64_t seed) {
+    if (n <= SHUFFLE_CHUNK) {
+        Random rng(seed);
+        shuffle(A, 0, n, rng);
+        return;
+    }
+    ThreadPool& pool = ThreadPool::instance();
+    int chunks = static_cast<int>((static_cast<long long>(n) + SHUFFLE_CHUNK - 1) / SHUFFLE_CHUNK);
+    int buckets = std::min(chunks, SHUFFLE_MAX_BUCKETS);
+    std::vector<std::uint32_t> tag(n);                              // 各元素所落入的桶
+    std::vector<Rank> count(static_cast<std::size_t>(chunks) * buckets, 0); // count[c * buckets + b]
+
+    pool.run(chunks, [&](int c) { // 为各元素选桶，并统计每块落入各桶的元素数
+        Random rng(seed, 2 * c);
+        Rank lo = c * SHUFFLE_CHUNK, hi = std::min(n, lo + SHUFFLE_CHUNK);
+        Rank* cnt = &count[static_cast<std::size_t>(c) * buckets];
+        for (Rank i = lo; i < hi; ++i) ++cnt[tag[i] = rng.below(buckets)];
+    });
+    std::vector<Rank> start(buckets + 1);
+    Rank offset = 0;
+    for (int b = 0; b < buckets; ++b) { // 计数转为各块在各桶中的写入位置
+        start[b] = offset;
+        for (int c = 0; c < chunks; ++c) {
+            Rank t = count[static_cast<std::size_t>(c) * buckets + b];
+            count[static_cast<std::size_t>(c) * buckets + b] = offset;
+            offset += t;
+        }
+    }
+    start[buckets] = n;
+
+    T* B = static_cast<T*>(std::malloc(sizeof(T) * n));
+    if (!B) throw std::bad_alloc();
+    pool.run(chunks, [&](int c) { // 按桶分配至 B
+        Rank lo = c * SHUFFLE_CHUNK, hi = std::min(n, lo + SHUFFLE_CHUNK);
+        Rank* pos = &count[static_cast<std::size_t>(c) * buckets];
+        for (Rank i = lo; i < hi; ++i)
+            ::new (static_cast<void*>(B + pos[tag[i]]++)) T(std::move(A[i]));
+    });
+    pool.run(buckets, [&](int b) { // 各桶分别置乱，并移回原数组
+        Random rng(seed, 2 * b + 1);
+        shuffle(B, start[b], start[b + 1], rng);
+        for (Rank i = start[b]; i < start[b + 1]; ++i) {
+            A[i] = std::move(B[i]);
+            if (!std::is_trivially_copyable<T>::value) B[i].~T();
+        }
+    });
+    std::free(B);
+}
+
+} // namespace dsa
+
+#endif // RANDOM_H
@@ -0,0 +1,129 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <algorithm> // std::min
+#include <cstddef>   // std::size_t
+#include <vector>    // std::vector
+
+typedef int Rank; // 秩
+
+#if defined(__GNUC__)
+#define DSA_PREFETCH(p) __builtin_prefetch(p)
+#else
+#define DSA_PREFETCH(p) ((void)0)
+#endif
+
+// 有序数组上的查找：返回不大于 e 的最后一个元素的秩，不存在时返回 lo - 1
+namespace dsa {
+
+const int SEARCH_BATCH = 16; // 批量查找时交错推进的查找数
+
+// 无分支二分查找：每步比较只决定区间起点的偏移(条件传送)，不产生难以预测的跳转
+template <typename T>
+Rank search(T const* A, Rank lo, Rank hi, T const& e) {
+    if (lo >= hi) return lo - 1;
+    T const* base = A + lo;
+    Rank n = hi - lo;
+    while (n > 1) {
+        Rank half = n >> 1;
+        base = (e < base[half]) ? base : base + half;
+        n -= half;
+    }
+    return static_cast<Rank>(base - A) - (e < *base);
+}
+
+// 批量无分支二分查找：SEARCH_BATCH 个查找逐层交错推进并预取下一层的探测位置，
+// 使多次缓存缺失相互重叠
+template <typename T>
+void searchMany(T const* A, Rank lo, Rank hi, T const* Q, Rank m, Rank* out) {
+    if (lo >= hi) {
+        for (Rank j = 0; j < m; ++j) out[j] = lo - 1;
+        return;
+    }
+    T const* base[SEARCH_BATCH];
+    for (Rank i = 0; i < m; i += SEARCH_BATCH) {
+        int g = static_cast<int>(std::min<Rank>(SEARCH_BATCH, m - i));
+        for (int j = 0; j < g; ++j) base[j] = A + lo;
+        for (Rank n = hi - lo; n > 1; n -= n >> 1) { // 各查找的区间长度同步变化
+            Rank half = n >> 1;
+            for (int j = 0; j < g; ++j) {
+                base[j] = (Q[i + j] < base[j][half]) ? base[j] : base[j] + half;
+                DSA_PREFETCH(base[j] + ((n - half) >> 1));
+            }
+        }
+        for (int j = 0; j < g; ++j)
+            out[i + j] = static_cast<Rank>(base[j] - A) - (Q[i + j] < *base[j]);
+    }
+}
+
+// 有序数组的只读查找索引：元素按 Eytzinger(BFS)顺序存放，
+// 第 k 个节点的孩子为 2k 与 2k + 1，前几层常驻缓存，且可提前预取后代所在的缓存行
+template <typename T>
+class SearchIndex {
+    std::vector<T> _node;    // _node[1, n]：按层次存放的元素
+    std::vector<Rank> _rank; // _rank[k]：_node[k] 在原有序数组中的秩
+    Rank _n;                 // 规模
+    int _depth;              // 树高 + 1
+
+    // 中序遍历位置 k 的子树，依次填入 A[i, ...)，返回下一个待填入元素的秩
+    Rank build(T const* A, Rank i, std::size_t k) {
+        if (k <= static_cast<std::size_t>(_n)) {
+            i = build(A, i, 2 * k);
+            _node[k] = A[i];
+            _rank[k] = i++;
+            i = build(A, i, 2 * k + 1);
+        }
+        return i;
+    }
+
+    // 查找终止于 k(已越过叶子)：回溯至最后一次向左转之处，即首个大于 e 的元素
+    Rank finish(std::size_t k) const {
+        while (k & 1) k >>= 1;
+        k >>= 1;
+        return k ? _rank[k] - 1 : _n - 1;
+    }
+
+public:
+    // 由有序数组 A[0, n) 构建
+    SearchIndex(T const* A, Rank n) : _n(n), _depth(0) {
+        if (n <= 0) { _n = 0; return; }
+        _node.assign(n + 1, A[0]);
+        _rank.assign(n + 1, 0);
+        build(A, 0, 1);
+        for (Rank m = n; m > 0; m >>= 1) ++_depth;
+    }
+
+    Rank size() const { return _n; }
+
+    // 不大于 e 的最后一个元素的秩，不存在时返回 -1
+    Rank search(T const& e) const {
+        T const* node = _node.data();
+        std::size_t k = 1, n = _n;
+        while (k <= n) {
+            DSA_PREFETCH(node + k * 16); // 四层之后的后代位于同一段连续空间
+            k = 2 * k + !(e < node[k]);
+        }
+        return finish(k);
+    }
+
+    // 批量查找 Q[0, m)，结果依次写入 out[0, m)
+    void search_many(T const* Q, Rank m, Rank* out) const {
+        T const* node = _node.data();
+        std::size_t n = _n, k[SEARCH_BATCH];
+        for (Rank i = 0; i < m; i += SEARCH_BATCH) {
+            int g = static_cast<int>(std::min<Rank>(SEARCH_BATCH, m - i));
+            for (int j = 0; j < g; ++j) k[j] = 1;
+            for (int level = 0; level < _depth; ++level)
+                for (int j = 0; j < g; ++j)
+                    if (k[j] <= n) {
+                        k[j] = 2 * k[j] + !(Q[i + j] < node[k[j]]);
+                        DSA_PREFETCH(node + k[j]);
+                    }
+            for (int j = 0; j < g; ++j) out[i + j] = finish(k[j]);
+        }
+    }
+};
+
+} // namespace dsa
+
+#endif // SEARCH_H
@@ -0,0 +1,222 @@
+#ifndef SELECT_H
+#define SELECT_H
+
+#include <algorithm>   // std::min, std::max
+#include <cstdint>     // std::uint8_t
+#include <cstdlib>     // std::malloc, std::free
+#include <functional>  // std::less
+#include <new>         // std::bad_alloc
+#include <type_traits> // std::is_trivially_copyable
+#include <utility>     // std::move, std::swap
+#include <vector>      // std::vector
+#include "Sort.h"      // choosePivot, partition, insertionSort, heapSort, introSort
+#include "Parallel.h"  // ThreadPool
+#include "Random.h"    // Random
+
+typedef int Rank; // 秩
+
+// 选取：不必整体排序即可得到第 k 小元素、最小的 k 个元素
+namespace dsa {
+
+// 内省选取：使秩为 k 的元素就位(lo <= k < hi)，其左侧不大于它、右侧不小于它
+// 沿用快速排序的轴点选取与划分，只进入包含 k 的一侧，期望 O(n)；
+// 划分轮数超过 2log(n) 时转为堆排序，最坏情况仍为 O(n log n)
+template <typename T>
+void introSelect(T* A, Rank lo, Rank hi, Rank k) {
+    int depth = 0;
+    for (Rank n = hi - lo; n > 1; n >>= 1) depth += 2;
+    while (hi - lo > INSERTION_SORT_THRESHOLD) {
+        if (depth-- == 0) { heapSort(A, lo, hi); return; }
+        choosePivot(A, lo, hi);
+        Rank mi = partition(A, lo, hi);
+        if (k == mi) return;
+        if (k < mi) hi = mi;
+        else lo = mi + 1;
+    }
+    insertionSort(A, lo, hi);
+}
+
+// 部分排序：A[lo, lo + k) 为区间内最小的 k 个元素且有序，其余元素次序不定
+// 先选取再排序前缀，O(n + k log k)
+template <typename T>
+void partialSort(T* A, Rank lo, Rank hi, Rank k) {
+    if (k <= 0) return;
+    if (k < hi - lo) introSelect(A, lo, hi, lo + k - 1);
+    else k = hi - lo;
+    introSort(A, lo, lo + k);
+}
+
+const Rank PARALLEL_SELECT_THRESHOLD = 1 << 17; // 规模不超过此值时顺序选取
+const Rank SELECT_SAMPLE = 1 << 14;             // 并行选取的样本数
+const Rank SELECT_BAND = 256;                   // 样本中目标位置两侧的余量
+
+// 并行选取 A[0, n) 中的第 k 小元素，结果与 introSelect 相同：
+// 1. 随机抽样，取样本中 k 对应位置两侧的元素为上下界 [a, b]
+// 2. 并行计数，若第 k 小元素落在 [a, b] 内，将此区间内的元素(约占 3%)并行收集并顺序选取，得到其值 v
+// 3. 按 v 并行三路划分(小于、等于、大于)，第 k 小元素随之就位
+// 样本不具代表性(概率极小)时退化为顺序选取
+template <typename T>
+void parallelSelect(T* A, Rank n, Rank k) {
+    if (n <= PARALLEL_SELECT_THRESHOLD) { introSelect(A, 0, n, k); return; }
+    ThreadPool& pool = ThreadPool::instance();
+    const Rank CHUNK = 1 << 16;
+    int chunks = static_cast<int>((static_cast<long long>(n) + CHUNK - 1) / CHUNK);
+    auto chunkRange = [&](int c, Rank& lo, Rank& hi) {
+        lo = static_cast<Rank>(static_cast<long long>(c) * CHUNK);
+        hi = std::min<Rank>(n, lo + CHUNK);
+    };
+
+    std::vector<T> sample; // 1. 抽样并确定上下界
+    sample.reserve(SELECT_SAMPLE);
+    Random rng(static_cast<std::uint64_t>(n) ^ static_cast<std::uint64_t>(k));
+    for (Rank i = 0; i < SELECT_SAMPLE; ++i) sample.push_back(A[rng.below(n)]);
+    introSort(sample.data(), 0, SELECT_SAMPLE);
+    Rank s = static_cast<Rank>(static_cast<long long>(k) * SELECT_SAMPLE / n);
+    T const& a = sample[std::max<Rank>(0, s - SELECT_BAND)];
+    T const& b = sample[std::min<Rank>(SELECT_SAMPLE - 1, s + SELECT_BAND)];
+
+    std::vector<Rank> below(chunks), band(chunks); // 2. 统计小于 a 及落在 [a, b] 内的元素数
+    pool.run(chunks, [&](int c) {
+        Rank lo, hi, l = 0, m = 0;
+        chunkRange(c, lo, hi);
+        for (Rank i = lo; i < hi; ++i) {
+            if (A[i] < a) ++l;
+            else if (!(b < A[i])) ++m;
+        }
+        below[c] = l;
+        band[c] = m;
+    });
+    Rank less = 0, inBand = 0;
+    for (int c = 0; c < chunks; ++c) {
+        Rank t = band[c];
+        band[c] = inBand; // 转为各块在收集区中的起始位置
+        inBand += t;
+        less += below[c];
+    }
+    if (k < less || less + inBand <= k) { introSelect(A, 0, n, k); return; }
+    std::vector<T> gathered(inBand);
+    pool.run(chunks, [&](int c) {
+        Rank lo, hi, j = band[c];
+        chunkRange(c, lo, hi);
+        for (Rank i = lo; i < hi; ++i)
+            if (!(A[i] < a) && !(b < A[i])) gathered[j++] = A[i];
+    });
+    introSelect(gathered.data(), 0, inBand, k - less);
+    T const v = gathered[k - less];
+
+    // 3. 按 v 三路划分：各块按类别计数，换算为写入位置后分配至辅助数组，再移回
+    std::vector<Rank> pos(3 * static_cast<std::size_t>(chunks));
+    std::vector<std::uint8_t> cls(n);
+    pool.run(chunks, [&](int c) {
+        Rank lo, hi, cnt[3] = {0, 0, 0};
+        chunkRange(c, lo, hi);
+        for (Rank i = lo; i < hi; ++i)
+            ++cnt[cls[i] = (A[i] < v) ? 0 : (v < A[i]) ? 2 : 1];
+        for (int t = 0; t < 3; ++t) pos[3 * c + t] = cnt[t];
+    });
+    Rank offset = 0;
+    for (int t = 0; t < 3; ++t)
+        for (int c = 0; c < chunks; ++c) {
+            Rank cnt = pos[3 * c + t];
+            pos[3 * c + t] = offset;
+            offset += cnt;
+        }
+    T* B = static_cast<T*>(std::malloc(sizeof(T) * n));
+    if (!B) throw std::bad_alloc();
+    pool.run(chunks, [&](int c) {
+        Rank lo, hi;
+        chunkRange(c, lo, hi);
+        Rank* p = &pos[3 * c];
+        for (Rank i = lo; i < hi; ++i)
+            ::new (static_cast<void*>(B + p[cls[i]]++)) T(std::move(A[i]));
+    });
+    pool.run(chunks, [&](int c) {
+        Rank lo, hi;
+        chunkRange(c, lo, hi);
+        for (Rank i = lo; i < hi; ++i) {
+            A[i] = std::move(B[i]);
+            if (!std::is_trivially_copyable<T>::value) B[i].~T();
+        }
+    });
+    std::free(B);
+}
+
+// 流式 top-k：逐个接收元素，只保留按 Compare 排在最前的 k 个(默认为最小的 k 个，
+// 取最大的 k 个时用 std::greater<T>)。以容量为 k 的堆维护，堆顶为当前保留者中最靠后的一个，
+// 每个元素 O(log k)，空间 O(k)
+template <typename T, typename Compare = std::less<T>>
+class TopK {
+    std::vector<T> _heap; // 堆顶为保留者中按 Compare 最靠后者
+    Rank _k;
+    Compare _before;
+
+    void siftUp(Rank i) {
+        T e = std::move(_heap[i]);
+        while (i > 0) {
+            Rank p = (i - 1) / 2;
+            if (!_before(_heap[p], e)) break;
+            _heap[i] = std::move(_heap[p]);
+            i = p;
+        }
+        _heap[i] = std::move(e);
+    }
+
+    void siftDown(Rank i) {
+        Rank n = static_cast<Rank>(_heap.size());
+        T e = std::move(_heap[i]);
+        Rank j;
+        while ((j = 2 * i + 1) < n) {
+            if (j + 1 < n && _before(_heap[j], _heap[j + 1])) ++j;
+            if (!_before(e, _heap[j])) break;
+            _heap[i] = std::move(_heap[j]);
+            i = j;
+        }
+        _heap[i] = std::move(e);
+    }
+
+public:
+    explicit TopK(Rank k, Compare before = Compare()) : _k(k), _before(before) {
+        _heap.reserve(k > 0 ? k : 0);
+    }
+
+    Rank size() const { return static_cast<Rank>(_heap.size()); } // 已保留的元素数
+    bool full() const { return size() >= _k; }
+    T const& top() const { return _heap.front(); } // 保留者中最靠后者(满时即第 k 名)
+
+    // 接收一个元素
+    void push(T const& e) {
+        if (_k <= 0) return;
+        if (!full()) {
+            _heap.push_back(e);
+            siftUp(size() - 1);
+        } else if (_before(e, _heap.front())) {
+            _heap.front() = e;
+            siftDown(0);
+        }
+    }
+
+    // 接收区间 A[lo, hi)
+    void push(T const* A, Rank lo, Rank hi) {
+        for (Rank i = lo; i < hi; ++i) push(A[i]);
+    }
+
+    // 按 Compare 次序输出保留的元素(依次写入 out[0, size()))，保留状态不变
+    void extract(T* out) const {
+        std::vector<T> h(_heap);
+        TopK copy(0, _before);
+        Rank n = size();
+        copy._heap.swap(h);
+        for (Rank i = n - 1; i >= 0; --i) { // 逐一摘除堆顶(最靠后者)，自后向前写出
+            out[i] = std::move(copy._heap.front());
+            copy._heap.front() = std::move(copy._heap.back());
+            copy._heap.pop_back();
+            if (!copy._heap.empty()) copy.siftDown(0);
+        }
+    }
+
+    void clear() { _heap.clear(); }
+};
+
+} // namespace dsa
+
+#endif // SELECT_H
@@ -0,0 +1,206 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <type_traits> // std::integral_constant
+
+typedef int Rank; // 秩
+
+// int/float/double 向量的查找、判序与求最大值：运行时按 CPU 支持选择 AVX2、SSE4.2 或标量实现
+// 仅 GCC 的 x86 目标启用向量化(依赖 #pragma GCC target 与 __builtin_cpu_supports)
+#if defined(__GNUC__) && !defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+#define DSA_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define DSA_SIMD_X86 0
+#endif
+
+namespace dsa {
+namespace simd {
+
+// 可向量化的元素类型
+template <typename T> struct Supported : std::integral_constant<bool, false> {};
+template <> struct Supported<int> : std::integral_constant<bool, true> {};
+template <> struct Supported<float> : std::integral_constant<bool, true> {};
+template <> struct Supported<double> : std::integral_constant<bool, true> {};
+
+// 标量版本：与 Vector 原有实现逐一对应
+template <typename T>
+Rank scalarFindLast(T const* A, Rank lo, Rank hi, T e) {
+    while ((lo < hi--) && (e != A[hi]));
+    return hi;
+}
+
+template <typename T>
+int scalarCountDescents(T const* A, Rank n) {
+    int cnt = 0;
+    for (Rank i = 1; i < n; ++i)
+        if (A[i - 1] > A[i]) ++cnt;
+    return cnt;
+}
+
+template <typename T>
+Rank scalarMaxRank(T const* A, Rank lo, Rank hi) {
+    Rank mx = lo;
+    for (Rank i = lo + 1; i < hi; ++i)
+        if (A[i] > A[mx]) mx = i;
+    return mx;
+}
+
+#if DSA_SIMD_X86
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+namespace avx2 {
+
+template <typename T> struct Lanes;
+
+template <> struct Lanes<int> {
+    typedef __m256i V;
+    static const int W = 8;
+    static V load(int const* p) { return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p)); }
+    static void store(int* p, V a) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a); }
+    static V set1(int e) { return _mm256_set1_epi32(e); }
+    static int eq(V a, V b) { return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))); }
+    static int gt(V a, V b) { return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(a, b))); }
+    static V max(V a, V b) { return _mm256_max_epi32(a, b); }
+    static int unordered(V) { return 0; }
+};
+
+template <> struct Lanes<float> {
+    typedef __m256 V;
+    static const int W = 8;
+    static V load(float const* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, V a) { _mm256_storeu_ps(p, a); }
+    static V set1(float e) { return _mm256_set1_ps(e); }
+    static int eq(V a, V b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+    static int gt(V a, V b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GT_OQ)); }
+    static V max(V a, V b) { return _mm256_max_ps(a, b); }
+    static int unordered(V a) { return _mm256_movemask_ps(_mm256_cmp_ps(a, a, _CMP_UNORD_Q)); }
+};
+
+template <> struct Lanes<double> {
+    typedef __m256d V;
+    static const int W = 4;
+    static V load(double const* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, V a) { _mm256_storeu_pd(p, a); }
+    static V set1(double e) { return _mm256_set1_pd(e); }
+    static int eq(V a, V b) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)); }
+    static int gt(V a, V b) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_GT_OQ)); }
+    static V max(V a, V b) { return _mm256_max_pd(a, b); }
+    static int unordered(V a) { return _mm256_movemask_pd(_mm256_cmp_pd(a, a, _CMP_UNORD_Q)); }
+};
+
+#include "SimdKernels.h"
+
+} // namespace avx2
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("sse4.2")
+namespace sse42 {
+
+template <typename T> struct Lanes;
+
+template <> struct Lanes<int> {
+    typedef __m128i V;
+    static const int W = 4;
+    static V load(int const* p) { return _mm_loadu_si128(reinterpret_cast<__m128i const*>(p)); }
+    static void store(int* p, V a) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), a); }
+    static V set1(int e) { return _mm_set1_epi32(e); }
+    static int eq(V a, V b) { return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))); }
+    static int gt(V a, V b) { return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(a, b))); }
+    static V max(V a, V b) { return _mm_max_epi32(a, b); }
+    static int unordered(V) { return 0; }
+};
+
+template <> struct Lanes<float> {
+    typedef __m128 V;
+    static const int W = 4;
+    static V load(float const* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, V a) { _mm_storeu_ps(p, a); }
+    static V set1(float e) { return _mm_set1_ps(e); }
+    static int eq(V a, V b) { return _mm_movemask_ps(_mm_cmpeq_ps(a, b)); }
+    static int gt(V a, V b) { return _mm_movemask_ps(_mm_cmpgt_ps(a, b)); }
+    static V max(V a, V b) { return _mm_max_ps(a, b); }
+    static int unordered(V a) { return _mm_movemask_ps(_mm_cmpunord_ps(a, a)); }
+};
+
+template <> struct Lanes<double> {
+    typedef __m128d V;
+    static const int W = 2;
+    static V load(double const* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, V a) { _mm_storeu_pd(p, a); }
+    static V set1(double e) { return _mm_set1_pd(e); }
+    static int eq(V a, V b) { return _mm_movemask_pd(_mm_cmpeq_pd(a, b)); }
+    static int gt(V a, V b) { return _mm_movemask_pd(_mm_cmpgt_pd(a, b)); }
+    static V max(V a, V b) { return _mm_max_pd(a, b); }
+    static int unordered(V a) { return _mm_movemask_pd(_mm_cmpunord_pd(a, a)); }
+};
+
+#include "SimdKernels.h"
+
+} // namespace sse42
+#pragma GCC pop_options
+
+#endif // DSA_SIMD_X86
+
+enum Isa { ISA_SCALAR, ISA_SSE42, ISA_AVX2 };
+
+// 当前 CPU 可用的最高指令集(首次调用时检测)
+inline Isa isa() {
+#if DSA_SIMD_X86
+    static const Isa detected = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return ISA_AVX2;
+        if (__builtin_cpu_supports("sse4.2")) return ISA_SSE42;
+        return ISA_SCALAR;
+    }();
+    return detected;
+#else
+    return ISA_SCALAR;
+#endif
+}
+
+// 最后一个等于 e 的元素的秩，不存在时返回 lo - 1
+template <typename T>
+Rank findLast(T const* A, Rank lo, Rank hi, T const& e) {
+#if DSA_SIMD_X86
+    switch (isa()) {
+        case ISA_AVX2: return avx2::findLast<T>(A, lo, hi, e);
+        case ISA_SSE42: return sse42::findLast<T>(A, lo, hi, e);
+        default: break;
+    }
+#endif
+    return scalarFindLast(A, lo, hi, e);
+}
+
+// 逆序相邻对的数目
+template <typename T>
+int countDescents(T const* A, Rank n) {
+#if DSA_SIMD_X86
+    switch (isa()) {
+        case ISA_AVX2: return avx2::countDescents<T>(A, n);
+        case ISA_SSE42: return sse42::countDescents<T>(A, n);
+        default: break;
+    }
+#endif
+    return scalarCountDescents(A, n);
+}
+
+// A[lo, hi) 中首个最大元素的秩
+template <typename T>
+Rank maxRank(T const* A, Rank lo, Rank hi) {
+#if DSA_SIMD_X86
+    switch (isa()) {
+        case ISA_AVX2: return avx2::maxRank<T>(A, lo, hi);
+        case ISA_SSE42: return sse42::maxRank<T>(A, lo, hi);
+        default: break;
+    }
+#endif
+    return scalarMaxRank(A, lo, hi);
+}
+
+} // namespace simd
+} // namespace dsa
+
+#endif // SIMD_H
@@ -0,0 +1,68 @@
+// 向量化查找/判序/求最大值的内核，只依赖 Lanes<T> 提供的通道操作
+// 本文件无包含保护：Simd.h 在不同指令集的 target 区域内各包含一次，
+// 每次都处于提供了相应 Lanes<T> 的命名空间之中
+
+// 最后一个等于 e 的元素的秩，不存在时返回 lo - 1
+template <typename T>
+Rank findLast(T const* A, Rank lo, Rank hi, T e) {
+    typedef Lanes<T> S;
+    typename S::V v = S::set1(e);
+    for (; hi - lo >= S::W; hi -= S::W) {
+        int m = S::eq(S::load(A + hi - S::W), v);
+        if (m) return hi - S::W + (31 - __builtin_clz(m));
+    }
+    while ((lo < hi--) && (e != A[hi]));
+    return hi;
+}
+
+// 第一个等于 e 的元素的秩，不存在时返回 hi
+template <typename T>
+Rank findFirst(T const* A, Rank lo, Rank hi, T e) {
+    typedef Lanes<T> S;
+    typename S::V v = S::set1(e);
+    for (; hi - lo >= S::W; lo += S::W) {
+        int m = S::eq(S::load(A + lo), v);
+        if (m) return lo + __builtin_ctz(m);
+    }
+    while (lo < hi && e != A[lo]) ++lo;
+    return lo;
+}
+
+// 逆序相邻对 A[i - 1] > A[i] (0 < i < n) 的数目
+template <typename T>
+int countDescents(T const* A, Rank n) {
+    typedef Lanes<T> S;
+    int cnt = 0;
+    Rank i = 1;
+    for (; i + S::W <= n; i += S::W)
+        cnt += __builtin_popcount(S::gt(S::load(A + i - 1), S::load(A + i)));
+    for (; i < n; ++i)
+        if (A[i - 1] > A[i]) ++cnt;
+    return cnt;
+}
+
+// A[lo, hi) 中首个最大元素的秩；含 NaN 时交由标量版本以保持原有语义
+template <typename T>
+Rank maxRank(T const* A, Rank lo, Rank hi) {
+    typedef Lanes<T> S;
+    if (hi - lo < 2 * S::W) return scalarMaxRank(A, lo, hi);
+    typename S::V m = S::load(A + lo);
+    int nan = S::unordered(m);
+    Rank i = lo + S::W;
+    for (; i + S::W <= hi; i += S::W) {
+        typename S::V x = S::load(A + i);
+        nan |= S::unordered(x);
+        m = S::max(m, x);
+    }
+    T lane[S::W];
+    S::store(lane, m);
+    T mx = lane[0];
+    for (int k = 1; k < S::W; ++k)
+        if (lane[k] > mx) mx = lane[k];
+    for (; i < hi; ++i) {
+        if (A[i] != A[i]) nan = 1;
+        else if (A[i] > mx) mx = A[i];
+    }
+    if (nan) return scalarMaxRank(A, lo, hi);
+    return findFirst(A, lo, hi, mx);
+}
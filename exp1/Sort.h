@@ -0,0 +1,155 @@
+#ifndef SORT_H
+#define SORT_H
+
+#include <utility> // std::move, std::swap
+
+typedef int Rank; // 秩
+
+// 基于比较的区间排序算法，均作用于数组区间 A[lo, hi)，只使用 operator<
+namespace dsa {
+
+const Rank INSERTION_SORT_THRESHOLD = 16; // 规模不超过此值的区间改用插入排序
+const Rank NINTHER_THRESHOLD = 128;       // 规模超过此值时以九数取中选取轴点
+
+// 插入排序：小区间上常数最小
+template <typename T>
+void insertionSort(T* A, Rank lo, Rank hi) {
+    for (Rank i = lo + 1; i < hi; ++i) {
+        if (!(A[i] < A[i - 1])) continue;
+        T e = std::move(A[i]);
+        Rank j = i;
+        do {
+            A[j] = std::move(A[j - 1]);
+        } while (--j > lo && e < A[j - 1]);
+        A[j] = std::move(e);
+    }
+}
+
+// 堆 H[0, n) 中秩为 i 的元素下滤
+template <typename T>
+void percolateDown(T* H, Rank n, Rank i) {
+    T e = std::move(H[i]);
+    Rank j;
+    while ((j = 2 * i + 1) < n) {
+        if (j + 1 < n && H[j] < H[j + 1]) ++j; // 取较大的孩子
+        if (!(e < H[j])) break;
+        H[i] = std::move(H[j]);
+        i = j;
+    }
+    H[i] = std::move(e);
+}
+
+// 堆排序：Floyd 建堆后逐一摘除堆顶，最坏情况 O(n log n)
+template <typename T>
+void heapSort(T* A, Rank lo, Rank hi) {
+    T* H = A + lo;
+    Rank n = hi - lo;
+    for (Rank i = n / 2 - 1; i >= 0; --i)
+        percolateDown(H, n, i);
+    while (n > 1) {
+        std::swap(H[0], H[--n]);
+        percolateDown(H, n, 0);
+    }
+}
+
+// 使 A[a] <= A[b] <= A[c]
+template <typename T>
+void sort3(T* A, Rank a, Rank b, Rank c) {
+    if (A[b] < A[a]) std::swap(A[a], A[b]);
+    if (A[c] < A[b]) std::swap(A[b], A[c]);
+    if (A[b] < A[a]) std::swap(A[a], A[b]);
+}
+
+// 选取轴点并将其置于 A[lo]：三数取中，大区间用九数取中(Tukey ninther)
+template <typename T>
+void choosePivot(T* A, Rank lo, Rank hi) {
+    Rank n = hi - lo, mi = lo + n / 2;
+    if (n > NINTHER_THRESHOLD) {
+        sort3(A, lo, mi, hi - 1);
+        sort3(A, lo + 1, mi - 1, hi - 2);
+        sort3(A, lo + 2, mi + 1, hi - 3);
+        sort3(A, mi - 1, mi, mi + 1);
+        std::swap(A[lo], A[mi]);
+    } else if (n > 2) {
+        sort3(A, mi, lo, hi - 1);
+    }
+}
+
+// 轴点构造：以 A[lo] 为轴点，返回其最终的秩
+// 与轴点相等的元素交替归入两侧，故大量重复元素时仍能均匀划分
+template <typename T>
+Rank partition(T* A, Rank lo, Rank hi) {
+    T pivot = std::move(A[lo]);
+    --hi;
+    while (lo < hi) {
+        while (lo < hi)
+            if (pivot < A[hi]) --hi;
+            else { A[lo++] = std::move(A[hi]); break; }
+        while (lo < hi)
+            if (A[lo] < pivot) ++lo;
+            else { A[hi--] = std::move(A[lo]); break; }
+    }
+    A[lo] = std::move(pivot);
+    return lo;
+}
+
+// 以 A[lo] 为轴点，将与之相等的元素集中于左侧(前提：区间内无更小者)
+// 返回首个大于轴点的元素的秩
+template <typename T>
+Rank partitionEqual(T* A, Rank lo, Rank hi) {
+    T const& pivot = A[lo];
+    Rank i = lo + 1, j = hi;
+    while (i < j) {
+        if (!(pivot < A[i])) ++i;
+        else if (pivot < A[j - 1]) --j;
+        else std::swap(A[i++], A[--j]);
+    }
+    return i;
+}
+
+// 内省排序：快速排序 + 小区间插入排序 + 递归过深时转堆排序
+// leftmost 为假时 A[lo - 1] 是上一轮的轴点，它不大于区间内任何元素；
+// 若新轴点与之相等，说明轴点即区间最小值，此时将等值元素一次性归并略去(三路划分)
+template <typename T>
+void introSort(T* A, Rank lo, Rank hi, int depth, bool leftmost) {
+    while (hi - lo > INSERTION_SORT_THRESHOLD) {
+        if (depth-- == 0) { heapSort(A, lo, hi); return; }
+        choosePivot(A, lo, hi);
+        if (!leftmost && !(A[lo - 1] < A[lo])) {
+            lo = partitionEqual(A, lo, hi);
+            continue;
+        }
+        Rank mi = partition(A, lo, hi);
+        if (mi - lo < hi - mi) { // 递归处理较短的一侧，较长的一侧就地迭代
+            introSort(A, lo, mi, depth, leftmost);
+            lo = mi + 1;
+            leftmost = false;
+        } else {
+            introSort(A, mi + 1, hi, depth, false);
+            hi = mi;
+        }
+    }
+    insertionSort(A, lo, hi);
+}
+
+template <typename T>
+void introSort(T* A, Rank lo, Rank hi) {
+    int depth = 0;
+    for (Rank n = hi - lo; n > 1; n >>= 1) depth += 2; // 递归深度上限 2log(n)
+    introSort(A, lo, hi, depth, true);
+}
+
+// 快速排序：不设深度上限，仅在较短一侧递归以控制栈深
+template <typename T>
+void quickSort(T* A, Rank lo, Rank hi) {
+    while (hi - lo > 1) {
+        choosePivot(A, lo, hi);
+        Rank mi = partition(A, lo, hi);
+        if (mi - lo < hi - mi) { quickSort(A, lo, mi); lo = mi + 1; }
+        else { quickSort(A, mi + 1, hi); hi = mi; }
+    }
+}
+
+} // namespace dsa
+
+#endif // SORT_H
@@ -2,85 +2,246 @@
 #define VECTOR_CPP
 
 #include "Vector.h"
+#include <cstring>   // std::memcpy, std::memmove
 #include <stdexcept> // std::out_of_range
 
+// 分配可容纳 n (>= 1) 个元素的未初始化空间：不超过 N 时使用内嵌缓冲区；N 为 0 时总在堆上，不返回空指针
+template <typename T, typename Alloc, int N>
+T* Vector<T, Alloc, N>::allocate(int n) {
+    if constexpr (N > 0) {
+        if (n <= N) return _inline.data();
+    }
+    if constexpr (MALLOC) {
+        T* p = static_cast<T*>(std::malloc(sizeof(T) * n));
+        if (!p) throw std::bad_alloc();
+        return p;
+    } else {
+        return Traits::allocate(_alloc, n);
+    }
+}
+
+// 释放 allocate 所得空间
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::deallocate(T* p, int n) {
+    if (!p || p == _inline.data()) return;
+    if constexpr (MALLOC) std::free(p);
+    else Traits::deallocate(_alloc, p, n);
+}
+
+// 析构 [first, last) 内的元素
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::destroy(T* first, T* last) {
+    if constexpr (TRIVIAL) return;
+    for (; first != last; ++first)
+        first->~T();
+}
+
+// 迁移至容量为 newCapacity 的新空间：元素被移动而非复制
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::reallocate(int newCapacity) {
+    if (newCapacity < N) newCapacity = N;
+    if (newCapacity < 1) newCapacity = 1; // 无内嵌缓冲区的空向量收紧后仍保留一个元素的空间
+    if (isInline() && newCapacity == N) return; // 仍在内嵌缓冲区中
+    if constexpr (MALLOC) {
+        if (newCapacity > N && !isInline()) { // 原地扩展或按字节整体搬运
+            T* p = static_cast<T*>(std::realloc(_elem, sizeof(T) * newCapacity));
+            if (!p) throw std::bad_alloc();
+            _elem = p;
+            _capacity = newCapacity;
+            return;
+        }
+    }
+    T* newElem = allocate(newCapacity);
+    if constexpr (TRIVIAL) {
+        if (_size) std::memcpy(static_cast<void*>(newElem), _elem, sizeof(T) * _size);
+    } else {
+        Rank i = 0;
+        try {
+            for (; i < _size; ++i) // 移动构造可能抛出异常时退化为复制，以保证原向量完好
+                ::new (static_cast<void*>(newElem + i)) T(std::move_if_noexcept(_elem[i]));
+        } catch (...) {
+            destroy(newElem, newElem + i);
+            deallocate(newElem, newCapacity);
+            throw;
+        }
+        destroy(_elem, _elem + _size);
+    }
+    deallocate(_elem, _capacity);
+    _elem = newElem;
+    _capacity = newCapacity;
+}
+
+// 接管 V 的全部元素：堆空间直接转手，内嵌缓冲区中的元素只能逐个移动
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::steal(Vector<T, Alloc, N>& V) {
+    if (V.isInline()) {
+        for (Rank i = 0; i < V._size; ++i)
+            ::new (static_cast<void*>(_elem + i)) T(std::move(V._elem[i]));
+        _size = V._size;
+        destroy(V._elem, V._elem + V._size);
+    } else {
+        _size = V._size; _capacity = V._capacity; _elem = V._elem;
+        V._elem = V._inline.data();
+        V._capacity = N;
+    }
+    V._size = 0;
+}
+
 // 构造函数
-template <typename T>
-Vector<T>::Vector(int c, int s, T v) : _size(s), _capacity(c) {
-    if (c < DEFAULT_CAPACITY) _capacity = DEFAULT_CAPACITY;
-    _elem = new T[_capacity];
-    for (_size = 0; _size < s; _elem[_size++] = v);
+template <typename T, typename Alloc, int N>
+Vector<T, Alloc, N>::Vector(int c, int s, T const& v, Alloc const& alloc)
+    : _size(0), _capacity(c), _alloc(alloc) {
+    if (_capacity < DEFAULT_CAPACITY) _capacity = DEFAULT_CAPACITY;
+    if (_capacity < s) _capacity = s;
+    if (_capacity < N) _capacity = N;
+    _elem = allocate(_capacity);
+    for (; _size < s; ++_size)
+        ::new (static_cast<void*>(_elem + _size)) T(v);
+}
+
+// 使用指定分配器的空向量
+template <typename T, typename Alloc, int N>
+Vector<T, Alloc, N>::Vector(Alloc const& alloc)
+    : _size(0), _capacity(INITIAL_CAPACITY), _alloc(alloc) {
+    _elem = allocate(_capacity);
 }
 
 // 数组整体复制
-template <typename T>
-Vector<T>::Vector(T const* A, Rank n) {
+template <typename T, typename Alloc, int N>
+Vector<T, Alloc, N>::Vector(T const* A, Rank n, Alloc const& alloc) : _alloc(alloc) {
     copyFrom(A, 0, n);
 }
 
 // 区间复制
-template <typename T>
-Vector<T>::Vector(T const* A, Rank lo, Rank hi) {
+template <typename T, typename Alloc, int N>
+Vector<T, Alloc, N>::Vector(T const* A, Rank lo, Rank hi, Alloc const& alloc) : _alloc(alloc) {
     copyFrom(A, lo, hi);
 }
 
 // 向量整体复制
-template <typename T>
-Vector<T>::Vector(Vector<T> const& V) {
+template <typename T, typename Alloc, int N>
+Vector<T, Alloc, N>::Vector(Vector<T, Alloc, N> const& V)
+    : _alloc(Traits::select_on_container_copy_construction(V._alloc)) {
     copyFrom(V._elem, 0, V._size);
 }
 
 // 向量区间复制
-template <typename T>
-Vector<T>::Vector(Vector<T> const& V, Rank lo, Rank hi) {
+template <typename T, typename Alloc, int N>
+Vector<T, Alloc, N>::Vector(Vector<T, Alloc, N> const& V, Rank lo, Rank hi)
+    : _alloc(Traits::select_on_container_copy_construction(V._alloc)) {
     copyFrom(V._elem, lo, hi);
 }
 
+// 移动构造：接管 V 的数据区与分配器
+template <typename T, typename Alloc, int N>
+Vector<T, Alloc, N>::Vector(Vector<T, Alloc, N>&& V) noexcept
+    : _size(0), _capacity(N), _alloc(std::move(V._alloc)) {
+    _elem = _inline.data();
+    steal(V);
+}
+
 // 析构函数
-template <typename T>
-Vector<T>::~Vector() {
-    delete[] _elem;
+template <typename T, typename Alloc, int N>
+Vector<T, Alloc, N>::~Vector() {
+    destroy(_elem, _elem + _size);
+    deallocate(_elem, _capacity);
 }
 
 // 复制数组区间 A[lo, hi)
-template <typename T>
-void Vector<T>::copyFrom(T const* A, Rank lo, Rank hi) {
-    if (lo < 0 || hi > (int)sizeof(A)/sizeof(A[0]) || lo > hi)
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::copyFrom(T const* A, Rank lo, Rank hi) {
+    if (lo < 0 || lo > hi)
         throw std::out_of_range("copyFrom: invalid lo or hi");
-    _elem = new T[_capacity = 2*(hi - lo)];
-    _size = 0;
-    for (Rank i = lo; i < hi; ++i)
-        _elem[_size++] = A[i];
+    _capacity = 2 * (hi - lo);
+    if (_capacity < DEFAULT_CAPACITY) _capacity = DEFAULT_CAPACITY;
+    if (_capacity < N) _capacity = N;
+    _elem = allocate(_capacity);
+    _size = hi - lo;
+    if constexpr (TRIVIAL) {
+        if (_size) std::memcpy(static_cast<void*>(_elem), A + lo, sizeof(T) * _size);
+        return;
+    }
+    try {
+        std::uninitialized_copy(A + lo, A + hi, _elem);
+    } catch (...) {
+        deallocate(_elem, _capacity);
+        _elem = nullptr;
+        _size = _capacity = 0;
+        throw;
+    }
 }
 
 // 扩容
-template <typename T>
-void Vector<T>::expand() {
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::expand() {
     if (_size < _capacity) return; // 仍有空间
-    _capacity = _capacity << 1; // 加倍
-    T* oldElem = _elem;
-    _elem = new T[_capacity];
-    for (Rank i = 0; i < _size; ++i)
-        _elem[i] = oldElem[i];
-    delete[] oldElem;
-}
-
-// 压缩
-template <typename T>
-void Vector<T>::shrink() {
-    if (_capacity < DEFAULT_CAPACITY << 1) return; // 容量不够压缩
-    if (_size << 2 > _capacity) return; // 装填因子仍然较高
-    _capacity = _capacity >> 1;
-    T* oldElem = _elem;
-    _elem = new T[_capacity];
-    for (Rank i = 0; i < _size; ++i)
-        _elem[i] = oldElem[i];
-    delete[] oldElem;
+    reallocate(_capacity < DEFAULT_CAPACITY ? DEFAULT_CAPACITY : _capacity << 1); // 加倍
+}
+
+// 预留空间：容量至少为 n，至多一次重新分配
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::reserve(int n) {
+    if (n > _capacity) reallocate(n);
+}
+
+// 压缩：容量收紧至规模(仅在显式调用时进行)
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::shrink_to_fit() {
+    if (_size < _capacity && !isInline()) reallocate(_size);
+}
+
+// 在秩 r 处腾出 k 个未构造的空位，返回其起点；需要扩容时只重新分配一次
+template <typename T, typename Alloc, int N>
+T* Vector<T, Alloc, N>::makeGap(Rank r, Rank k) {
+    if (_size + k > _capacity) { // 前后两段直接迁入新空间的相应位置
+        int newCapacity = _capacity << 1;
+        if (newCapacity < _size + k) newCapacity = _size + k;
+        if (newCapacity < DEFAULT_CAPACITY) newCapacity = DEFAULT_CAPACITY;
+        T* newElem = allocate(newCapacity);
+        relocate(_elem, r, newElem);
+        relocate(_elem + r, _size - r, newElem + r + k);
+        deallocate(_elem, _capacity);
+        _elem = newElem;
+        _capacity = newCapacity;
+    } else if constexpr (TRIVIAL) {
+        if (r < _size) std::memmove(static_cast<void*>(_elem + r + k), _elem + r, sizeof(T) * (_size - r));
+    } else { // 后缀整体后移 k 位：落在原规模之外者移动构造，其余移动赋值
+        for (Rank i = _size - 1; i >= r; --i)
+            if (i + k >= _size) ::new (static_cast<void*>(_elem + i + k)) T(std::move(_elem[i]));
+            else _elem[i + k] = std::move(_elem[i]);
+        destroy(_elem + r, _elem + (r + k < _size ? r + k : _size));
+    }
+    return _elem + r;
+}
+
+// 将 src[0, n) 移至未构造的 dst[0, n)，并析构 src 中的元素
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::relocate(T* src, Rank n, T* dst) {
+    if constexpr (TRIVIAL) {
+        if (n) std::memcpy(static_cast<void*>(dst), src, sizeof(T) * n);
+    } else {
+        for (Rank i = 0; i < n; ++i)
+            ::new (static_cast<void*>(dst + i)) T(std::move(src[i]));
+        destroy(src, src + n);
+    }
+}
+
+// 规模
+template <typename T, typename Alloc, int N>
+Rank Vector<T, Alloc, N>::size() const {
+    return _size;
+}
+
+// 判空
+template <typename T, typename Alloc, int N>
+bool Vector<T, Alloc, N>::empty() const {
+    return !_size;
 }
 
 // 判断向量是否已排序
-template <typename T>
-int Vector<T>::disordered() const {
+template <typename T, typename Alloc, int N>
+int Vector<T, Alloc, N>::disordered() const {
+    if constexpr (dsa::simd::Supported<T>::value) return dsa::simd::countDescents(_elem, _size);
     int n = 0;
     for (Rank i = 1; i < _size; ++i)
         if (_elem[i-1] > _elem[i]) ++n;
@@ -88,131 +249,273 @@ int Vector<T>::disordered() const {
 }
 
 // 无序向量整体查找
-template <typename T>
-Rank Vector<T>::find(T const& e) const {
+template <typename T, typename Alloc, int N>
+Rank Vector<T, Alloc, N>::find(T const& e) const {
     return find(e, 0, _size);
 }
 
 // 无序向量区间查找
-template <typename T>
-Rank Vector<T>::find(T const& e, Rank lo, Rank hi) const {
+template <typename T, typename Alloc, int N>
+Rank Vector<T, Alloc, N>::find(T const& e, Rank lo, Rank hi) const {
+    if constexpr (dsa::simd::Supported<T>::value) return dsa::simd::findLast(_elem, lo, hi, e);
     while ((lo < hi--) && (e != _elem[hi]));
     return hi;
 }
 
 // 有序向量整体查找
-template <typename T>
-Rank Vector<T>::search(T const& e) const {
+template <typename T, typename Alloc, int N>
+Rank Vector<T, Alloc, N>::search(T const& e) const {
     return (_size > 0) ? search(e, 0, _size) : -1;
 }
 
 // 有序向量区间查找
-template <typename T>
-Rank Vector<T>::search(T const& e, Rank lo, Rank hi) const {
-    // 二分查找
-    while (lo < hi) {
-        Rank mi = (lo + hi) / 2;
-        if (e < _elem[mi]) hi = mi;
-        else lo = mi + 1;
-    }
-    return --lo;
+template <typename T, typename Alloc, int N>
+Rank Vector<T, Alloc, N>::search(T const& e, Rank lo, Rank hi) const {
+    return dsa::search(_elem, lo, hi, e); // 无分支二分查找
+}
+
+// 有序向量批量查找：out[i] 为 queries[i] 的查找结果
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::search_many(Vector<T, Alloc, N> const& queries, Vector<Rank>& out) const {
+    out = Vector<Rank>(queries._size, queries._size);
+    dsa::searchMany(_elem, 0, _size, queries._elem, queries._size, out._elem);
+}
+
+// 为有序向量构建静态查找索引(Eytzinger 布局)
+template <typename T, typename Alloc, int N>
+dsa::SearchIndex<T> Vector<T, Alloc, N>::buildIndex() const {
+    return dsa::SearchIndex<T>(_elem, _size);
 }
 
 // 重载下标操作符
-template <typename T>
-T& Vector<T>::operator[](Rank r) const {
+template <typename T, typename Alloc, int N>
+T& Vector<T, Alloc, N>::operator[](Rank r) const {
     if (r < 0 || r >= _size)
         throw std::out_of_range("Vector index out of range");
     return _elem[r];
 }
 
 // 重载赋值操作符
-template <typename T>
-Vector<T>& Vector<T>::operator=(Vector<T> const& V) {
-    if (_elem) delete[] _elem;
-    copyFrom(V._elem, 0, V._size);
+template <typename T, typename Alloc, int N>
+Vector<T, Alloc, N>& Vector<T, Alloc, N>::operator=(Vector<T, Alloc, N> const& V) {
+    if (this == &V) return *this;
+    Vector<T, Alloc, N> copy(V._elem, 0, V._size, _alloc); // 先复制成功再替换，异常时原向量不受影响
+    return *this = std::move(copy);
+}
+
+// 移动赋值：分配器相容时直接接管 V 的数据区，否则逐个移动元素
+template <typename T, typename Alloc, int N>
+Vector<T, Alloc, N>& Vector<T, Alloc, N>::operator=(Vector<T, Alloc, N>&& V) {
+    if (this == &V) return *this;
+    destroy(_elem, _elem + _size);
+    _size = 0;
+    if (Traits::propagate_on_container_move_assignment::value || _alloc == V._alloc) {
+        deallocate(_elem, _capacity);
+        _elem = _inline.data();
+        _capacity = N;
+        if constexpr (Traits::propagate_on_container_move_assignment::value)
+            _alloc = std::move(V._alloc);
+        steal(V);
+    } else {
+        if (_capacity < V._size) reallocate(V._size);
+        for (; _size < V._size; ++_size)
+            ::new (static_cast<void*>(_elem + _size)) T(std::move(V._elem[_size]));
+        V.truncate(0);
+    }
     return *this;
 }
 
 // 删除秩为 r 的元素
-template <typename T>
-T Vector<T>::remove(Rank r) {
+template <typename T, typename Alloc, int N>
+T Vector<T, Alloc, N>::remove(Rank r) {
     if (r < 0 || r >= _size)
         throw std::out_of_range("remove: invalid rank");
-    T e = _elem[r];
-    for (Rank i = r; i < _size - 1; ++i)
-        _elem[i] = _elem[i + 1];
-    --_size;
-    shrink();
+    T e = std::move(_elem[r]);
+    remove(r, r + 1);
     return e;
 }
 
-// 删除秩在区间 [lo, hi) 之内的元素
-template <typename T>
-int Vector<T>::remove(Rank lo, Rank hi) {
+// 删除秩在区间 [lo, hi) 之内的元素：后缀整体前移一次，不压缩容量
+template <typename T, typename Alloc, int N>
+int Vector<T, Alloc, N>::remove(Rank lo, Rank hi) {
     if (lo < 0 || hi > _size || lo > hi)
         throw std::out_of_range("remove: invalid lo or hi");
     if (lo == hi) return 0;
+    if constexpr (TRIVIAL) {
+        std::memmove(static_cast<void*>(_elem + lo), _elem + hi, sizeof(T) * (_size - hi));
+        _size -= hi - lo;
+        return hi - lo;
+    }
     while (hi < _size)
-        _elem[lo++] = _elem[hi++];
+        _elem[lo++] = std::move(_elem[hi++]);
     int removed = hi - lo;
+    destroy(_elem + lo, _elem + _size);
     _size = lo;
-    shrink();
     return removed;
 }
 
 // 插入元素
-template <typename T>
-Rank Vector<T>::insert(Rank r, T const& e) {
+template <typename T, typename Alloc, int N>
+Rank Vector<T, Alloc, N>::insert(Rank r, T const& e) {
+    return emplace(r, e);
+}
+
+// 插入元素(移动)
+template <typename T, typename Alloc, int N>
+Rank Vector<T, Alloc, N>::insert(Rank r, T&& e) {
+    return emplace(r, std::move(e));
+}
+
+// 默认作为末元素插入
+template <typename T, typename Alloc, int N>
+Rank Vector<T, Alloc, N>::insert(T const& e) {
+    emplace_back(e);
+    return _size - 1;
+}
+
+// 默认作为末元素插入(移动)
+template <typename T, typename Alloc, int N>
+Rank Vector<T, Alloc, N>::insert(T&& e) {
+    emplace_back(std::move(e));
+    return _size - 1;
+}
+
+// 在秩 r 处插入区间 [first, last) 中的元素(不得取自本向量)：至多一次重新分配、一次整体后移
+template <typename T, typename Alloc, int N>
+template <typename It, typename>
+Rank Vector<T, Alloc, N>::insert(Rank r, It first, It last) {
     if (r < 0 || r > _size)
         throw std::out_of_range("insert: invalid rank");
-    expand();
-    for (Rank i = _size; i > r; --i)
-        _elem[i] = _elem[i - 1];
-    _elem[r] = e;
+    typedef typename std::iterator_traits<It>::iterator_category Category;
+    if constexpr (!std::is_base_of<std::forward_iterator_tag, Category>::value) { // 单趟迭代器须先暂存
+        Vector<T, Alloc, N> buffer(_alloc);
+        for (; first != last; ++first) buffer.emplace_back(*first);
+        return insert(r, std::make_move_iterator(buffer._elem), std::make_move_iterator(buffer._elem + buffer._size));
+    } else {
+        Rank k = static_cast<Rank>(std::distance(first, last));
+        if (k == 0) return r;
+        T* gap = makeGap(r, k);
+        if constexpr (TRIVIAL && std::is_pointer<It>::value &&
+                      std::is_same<typename std::remove_cv<typename std::remove_pointer<It>::type>::type, T>::value) {
+            std::memcpy(static_cast<void*>(gap), first, sizeof(T) * k);
+        } else {
+            for (Rank i = 0; i < k; ++i, ++first)
+                ::new (static_cast<void*>(gap + i)) T(*first);
+        }
+        _size += k;
+        return r;
+    }
+}
+
+// 在末尾追加区间 [first, last) 中的元素
+template <typename T, typename Alloc, int N>
+template <typename It, typename>
+void Vector<T, Alloc, N>::append(It first, It last) {
+    insert(_size, first, last);
+}
+
+// 以区间 [first, last) 中的元素替换全部内容
+template <typename T, typename Alloc, int N>
+template <typename It, typename>
+void Vector<T, Alloc, N>::assign(It first, It last) {
+    truncate(0);
+    insert(0, first, last);
+}
+
+// 以 n 个 v 的副本替换全部内容
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::assign(int n, T const& v) {
+    T e(v); // v 可能引用本向量中的元素
+    truncate(0);
+    reserve(n);
+    for (; _size < n; ++_size)
+        ::new (static_cast<void*>(_elem + _size)) T(e);
+}
+
+// 在秩 r 处就地构造元素
+template <typename T, typename Alloc, int N>
+template <typename... Args>
+Rank Vector<T, Alloc, N>::emplace(Rank r, Args&&... args) {
+    if (r < 0 || r > _size)
+        throw std::out_of_range("emplace: invalid rank");
+    if (r == _size) {
+        emplace_back(std::forward<Args>(args)...);
+        return r;
+    }
+    T e(std::forward<Args>(args)...); // 先构造：参数可能引用本向量中的元素
+    ::new (static_cast<void*>(makeGap(r, 1))) T(std::move(e));
     ++_size;
     return r;
 }
 
-// 默认作为末元素插入
-template <typename T>
-Rank Vector<T>::insert(T const& e) {
-    return insert(_size, e);
+// 在末尾就地构造元素
+template <typename T, typename Alloc, int N>
+template <typename... Args>
+T& Vector<T, Alloc, N>::emplace_back(Args&&... args) {
+    if (_size < _capacity) {
+        ::new (static_cast<void*>(_elem + _size)) T(std::forward<Args>(args)...);
+    } else { // 扩容会使参数所引用的本向量元素失效，故先构造
+        T e(std::forward<Args>(args)...);
+        expand();
+        ::new (static_cast<void*>(_elem + _size)) T(std::move(e));
+    }
+    return _elem[_size++];
+}
+
+// 截断：只保留前 n 个元素，返回被删除的元素数
+template <typename T, typename Alloc, int N>
+int Vector<T, Alloc, N>::truncate(Rank n) {
+    int removed = _size - n;
+    destroy(_elem + n, _elem + _size);
+    _size = n;
+    return removed;
+}
+
+// 去重(无序向量)：可散列的类型期望 O(n)，否则 O(n^2)；均一趟压缩，保留首次出现者
+template <typename T, typename Alloc, int N>
+int Vector<T, Alloc, N>::deduplicate() {
+    if constexpr (dsa::IsHashable<T>::value) {
+        return truncate(dsa::deduplicate(_elem, _size));
+    } else {
+        Rank j = 0; // _elem[0, j) 为已保留的互异元素
+        for (Rank i = 0; i < _size; ++i)
+            if (find(_elem[i], 0, j) < 0) {
+                if (i != j) _elem[j] = std::move(_elem[i]);
+                ++j;
+            }
+        return truncate(j);
+    }
 }
 
-// 去重(无序向量)
-template <typename T>
-int Vector<T>::deduplicate() {
-    int oldSize = _size;
-    Rank i = 1;
-    while (i < _size)
-        (find(_elem[i], 0, i) < 0) ? ++i : remove(i);
-    return oldSize - _size;
+// 去重(无序向量)：散列表至多约 budget 项，以多趟扫描换取有限的内存
+template <typename T, typename Alloc, int N>
+int Vector<T, Alloc, N>::deduplicate(Rank budget) {
+    if constexpr (dsa::IsHashable<T>::value)
+        return truncate(dsa::deduplicate(_elem, _size, budget));
+    else
+        return deduplicate();
 }
 
 // 去重(有序向量)
-template <typename T>
-int Vector<T>::uniquify() {
+template <typename T, typename Alloc, int N>
+int Vector<T, Alloc, N>::uniquify() {
     if (_size < 2) return 0;
-    Rank i = 1, j = 1;
-    while (++i < _size)
-        if (_elem[i - 1] != _elem[i])
-            _elem[j++] = _elem[i];
-    int removed = _size - j;
-    _size = j;
-    shrink();
-    return removed;
+    Rank i = 0, j = 0; // _elem[0, i] 为已保留的互异元素
+    while (++j < _size)
+        if (_elem[i] != _elem[j] && ++i != j) // 与最后保留者比较，避免读取已被移走的元素
+            _elem[i] = std::move(_elem[j]);
+    return truncate(i + 1);
 }
 
 // 起泡排序算法
-template <typename T>
-void Vector<T>::bubbleSort(Rank lo, Rank hi) {
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::bubbleSort(Rank lo, Rank hi) {
     while (!bubble(lo, hi--));
 }
 
 // 扫描交换
-template <typename T>
-bool Vector<T>::bubble(Rank lo, Rank hi) {
+template <typename T, typename Alloc, int N>
+bool Vector<T, Alloc, N>::bubble(Rank lo, Rank hi) {
     bool sorted = true;
     while (++lo < hi)
         if (_elem[lo - 1] > _elem[lo]) {
@@ -223,17 +526,16 @@ bool Vector<T>::bubble(Rank lo, Rank hi) {
 }
 
 // 选择排序算法
-template <typename T>
-void Vector<T>::selectionSort(Rank lo, Rank hi) {
-    for (Rank i = lo; i < hi - 1; ++i) {
-        Rank maxRank = max(lo, hi);
-        std::swap(_elem[maxRank], _elem[hi - 1]);
-    }
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::selectionSort(Rank lo, Rank hi) {
+    while (lo < --hi) // 每轮将 [lo, hi] 中的最大者交换至 hi
+        std::swap(_elem[max(lo, hi + 1)], _elem[hi]);
 }
 
 // 选取最大元素
-template <typename T>
-Rank Vector<T>::max(Rank lo, Rank hi) {
+template <typename T, typename Alloc, int N>
+Rank Vector<T, Alloc, N>::max(Rank lo, Rank hi) {
+    if constexpr (dsa::simd::Supported<T>::value) return dsa::simd::maxRank(_elem, lo, hi);
     Rank maxRank = lo;
     for (Rank i = lo + 1; i < hi; ++i)
         if (_elem[i] > _elem[maxRank])
@@ -241,107 +543,159 @@ Rank Vector<T>::max(Rank lo, Rank hi) {
     return maxRank;
 }
 
-// 归并排序算法
-template <typename T>
-void Vector<T>::mergeSort(Rank lo, Rank hi) {
-    if (hi - lo < 2) return;
-    Rank mi = (lo + hi) / 2;
-    mergeSort(lo, mi);
-    mergeSort(mi, hi);
-    merge(lo, mi, hi);
-}
-
-// 归并算法
-template <typename T>
-void Vector<T>::merge(Rank lo, Rank mi, Rank hi) {
-    T* A = _elem + lo;
-    int lb = mi - lo;
-    T* B = new T[lb];
-    for (int i = 0; i < lb; ++i)
-        B[i] = A[i];
-    int lc = hi - mi;
-    T* C = _elem + mi;
-    int i = 0, j = 0, k = 0;
-    while (j < lb && k < lc)
-        A[i++] = (B[j] <= C[k]) ? B[j++] : C[k++];
-    while (j < lb)
-        A[i++] = B[j++];
-    while (k < lc)
-        A[i++] = C[k++];
-    delete[] B;
+// 归并排序算法：自底向上，只分配一次辅助空间
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::mergeSort(Rank lo, Rank hi) {
+    dsa::mergeSort(_elem, lo, hi, 1);
 }
 
 // 快速排序算法
-template <typename T>
-void Vector<T>::quickSort(Rank lo, Rank hi) {
-    if (hi - lo < 2) return;
-    Rank mi = partition(lo, hi);
-    quickSort(lo, mi);
-    quickSort(mi + 1, hi);
-}
-
-// 轴点构造算法
-template <typename T>
-Rank Vector<T>::partition(Rank lo, Rank hi) {
-    std::swap(_elem[lo], _elem[lo + std::rand() % (hi - lo)]);
-    T pivot = _elem[lo];
-    while (lo < hi) {
-        while (lo < hi && _elem[--hi] >= pivot);
-        if (lo < hi) _elem[lo] = _elem[hi];
-        while (lo < hi && _elem[++lo] <= pivot);
-        if (lo < hi) _elem[hi] = _elem[lo];
-    }
-    _elem[lo] = pivot;
-    return lo;
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::quickSort(Rank lo, Rank hi) {
+    dsa::quickSort(_elem, lo, hi);
+}
+
+// 轴点构造算法：三数(九数)取中选取轴点，返回其最终的秩
+template <typename T, typename Alloc, int N>
+Rank Vector<T, Alloc, N>::partition(Rank lo, Rank hi) {
+    dsa::choosePivot(_elem, lo, hi);
+    return dsa::partition(_elem, lo, hi);
 }
 
 // 堆排序算法
-template <typename T>
-void Vector<T>::heapSort(Rank lo, Rank hi) {
-    // 建立堆
-    // 省略实现，作为示例
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::heapSort(Rank lo, Rank hi) {
+    dsa::heapSort(_elem, lo, hi);
 }
 
-// 排序接口
-template <typename T>
-void Vector<T>::sort(Rank lo, Rank hi) {
-    // 选择一种排序算法，这里以快速排序为例
-    quickSort(lo, hi);
+// 排序接口：整数与 IEEE 浮点数用基数排序，其余类型用内省排序(最坏情况 O(n log n))
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::sort(Rank lo, Rank hi) {
+    if constexpr (dsa::RadixSortable<T>::value) dsa::radixSort(_elem, lo, hi);
+    else dsa::introSort(_elem, lo, hi);
 }
 
 // 整体排序
-template <typename T>
-void Vector<T>::sort() {
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::sort() {
     sort(0, _size);
 }
 
-// 置乱
-template <typename T>
-void Vector<T>::unsort(Rank lo, Rank hi) {
-    std::srand(unsigned(std::time(0)));
-    for (Rank i = lo; i < hi; ++i)
-        std::swap(_elem[i], _elem[lo + std::rand() % (hi - lo)]);
+// 稳定排序 [lo, hi)：多线程归并排序，threads 不大于 0 时取硬件并发数
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::stableSort(Rank lo, Rank hi, int threads) {
+    if (lo < 0 || hi > _size || lo > hi)
+        throw std::out_of_range("stableSort: invalid lo or hi");
+    dsa::mergeSort(_elem, lo, hi, threads);
+}
+
+// 整体稳定排序
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::stableSort(int threads) {
+    stableSort(0, _size, threads);
+}
+
+// 选取：使 [lo, hi) 中秩为 k 的元素就位，左侧不大于它、右侧不小于它
+template <typename T, typename Alloc, int N>
+T& Vector<T, Alloc, N>::nth_element(Rank lo, Rank hi, Rank k) {
+    if (lo < 0 || hi > _size || k < lo || k >= hi)
+        throw std::out_of_range("nth_element: invalid lo, hi or k");
+    dsa::introSelect(_elem, lo, hi, k);
+    return _elem[k];
+}
+
+// 整体选取
+template <typename T, typename Alloc, int N>
+T& Vector<T, Alloc, N>::nth_element(Rank k) {
+    return nth_element(0, _size, k);
+}
+
+// 整体并行选取
+template <typename T, typename Alloc, int N>
+T& Vector<T, Alloc, N>::nth_element(dsa::ParallelPolicy, Rank k) {
+    if (k < 0 || k >= _size)
+        throw std::out_of_range("nth_element: invalid k");
+    dsa::parallelSelect(_elem, _size, k);
+    return _elem[k];
+}
+
+// 部分排序：前 k 个元素为最小的 k 个且有序
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::partial_sort(Rank k) {
+    dsa::partialSort(_elem, 0, _size, k);
+}
+
+// 置乱(使用当前线程的默认发生器)
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::unsort(Rank lo, Rank hi) {
+    dsa::shuffle(_elem, lo, hi, dsa::threadRandom());
+}
+
+// 置乱(使用指定的发生器，结果可复现)
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::unsort(Rank lo, Rank hi, dsa::Random& rng) {
+    dsa::shuffle(_elem, lo, hi, rng);
 }
 
 // 整体置乱
-template <typename T>
-void Vector<T>::unsort() {
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::unsort() {
     unsort(0, _size);
 }
 
+// 整体并行置乱：结果只由 seed 决定
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::unsort(dsa::ParallelPolicy, std::uint64_t seed) {
+    dsa::parallelShuffle(_elem, _size, seed);
+}
+
 // 遍历(使用函数指针)
-template <typename T>
-void Vector<T>::traverse(void (*visit)(T&)) {
+template <typename T, typename Alloc, int N>
+void Vector<T, Alloc, N>::traverse(void (*visit)(T&)) {
     for (Rank i = 0; i < _size; ++i)
         visit(_elem[i]);
 }
 
 // 遍历(使用函数对象)
-template <typename T>
+template <typename T, typename Alloc, int N>
 template <typename VST>
-void Vector<T>::traverse(VST& visit) {
+void Vector<T, Alloc, N>::traverse(VST& visit) {
     for (Rank i = 0; i < _size; ++i)
         visit(_elem[i]);
 }
 
+// 遍历(带执行策略)
+template <typename T, typename Alloc, int N>
+template <typename Policy, typename VST>
+void Vector<T, Alloc, N>::traverse(Policy const& policy, VST&& visit) {
+    dsa::forEach(policy, _elem, _size, visit);
+}
+
+// 变换(带执行策略)
+template <typename T, typename Alloc, int N>
+template <typename Policy, typename F>
+void Vector<T, Alloc, N>::transform(Policy const& policy, F&& f) {
+    dsa::transform(policy, _elem, _size, f);
+}
+
+// 归约(带执行策略)
+template <typename T, typename Alloc, int N>
+template <typename Policy, typename R, typename Op>
+R Vector<T, Alloc, N>::reduce(Policy const& policy, R init, Op&& op) const {
+    return dsa::reduce(policy, _elem, _size, init, op);
+}
+
+template <typename T, typename Alloc, int N>
+template <typename Policy, typename R, typename Op, typename Combine>
+R Vector<T, Alloc, N>::reduce(Policy const& policy, R init, Op&& op, Combine&& combine) const {
+    return dsa::reduce(policy, _elem, _size, init, op, combine);
+}
+
+// 计数(带执行策略)
+template <typename T, typename Alloc, int N>
+template <typename Policy, typename Pred>
+Rank Vector<T, Alloc, N>::count_if(Policy const& policy, Pred&& pred) const {
+    return dsa::countIf(policy, _elem, _size, pred);
+}
+
 #endif // VECTOR_CPP
@@ -2,39 +2,91 @@
 #define VECTOR_H
 
 #include <algorithm> // std::swap
-#include <cstdlib>   // std::rand, std::srand
-#include <ctime>     // std::time
+#include <cstdint>   // std::uint64_t
+#include <cstdlib>   // std::malloc, std::realloc, std::free
+#include <iterator>  // std::iterator_traits, std::distance, std::make_move_iterator
+#include <memory>    // std::allocator, std::allocator_traits
+#include <new>       // placement new
+#include <type_traits> // std::is_trivially_copyable
+#include <utility>   // std::move, std::forward
+#include "Sort.h"    // 区间排序算法
+#include "Parallel.h" // 线程池与执行策略
+#include "MergeSort.h" // 并行归并排序
+#include "RadixSort.h" // 基数排序
+#include "Simd.h"    // 向量化查找、判序与求最大值
+#include "Search.h"  // 无分支查找与静态查找索引
+#include "Dedup.h"   // 散列去重
+#include "Arena.h"   // 单调分配区与相应的分配器
+#include "Random.h"  // 伪随机数发生器与置乱
+#include "Select.h"  // 选取与 top-k
 
 typedef int Rank; // 秩
 #define DEFAULT_CAPACITY 3 // 默认的初始容量(实际应用中可设置为更大)
 
+// 内嵌缓冲区：容量不超过 N 时元素直接存放于向量对象之中，无需堆分配
+template <typename T, int N>
+struct InlineBuffer {
+    alignas(T) unsigned char bytes[sizeof(T) * N];
+    T* data() { return reinterpret_cast<T*>(bytes); }
+    T const* data() const { return reinterpret_cast<T const*>(bytes); }
+};
+
 template <typename T>
+struct InlineBuffer<T, 0> {
+    T* data() { return nullptr; }
+    T const* data() const { return nullptr; }
+};
+
+// Alloc 为分配器(可换用 Arena.h 中的 ArenaAllocator)，N 为内嵌缓冲区的容量
+template <typename T, typename Alloc = std::allocator<T>, int N = 0>
 class Vector { // 向量模板类
+    template <typename, typename, int> friend class Vector;
+
 protected:
     Rank _size;        // 规模
     int _capacity;     // 容量
-    T* _elem;          // 数据区
+    T* _elem;          // 数据区(仅 [0, _size) 内的元素已构造)
+    Alloc _alloc;      // 分配器
+    InlineBuffer<T, N> _inline; // 内嵌缓冲区
+
+    typedef std::allocator_traits<Alloc> Traits;
+    // 平凡可复制类型直接按字节搬运(memcpy)，其余类型逐个移动构造
+    static constexpr bool TRIVIAL = std::is_trivially_copyable<T>::value;
+    // 使用默认分配器的平凡类型改由 malloc/realloc 管理，扩容时可原地延展
+    static constexpr bool MALLOC = TRIVIAL && std::is_same<Alloc, std::allocator<T>>::value;
+    static constexpr int INITIAL_CAPACITY = N > DEFAULT_CAPACITY ? N : DEFAULT_CAPACITY;
 
+    bool isInline() const { return N > 0 && _elem == _inline.data(); } // 数据区是否为内嵌缓冲区
+    T* allocate(int n); // 分配可容纳 n 个元素的未初始化空间
+    void deallocate(T* p, int n); // 释放 allocate 所得空间
+    static void destroy(T* first, T* last); // 析构 [first, last) 内的元素
+    void reallocate(int newCapacity); // 迁移至容量为 newCapacity 的新空间
+    void steal(Vector& V); // 接管 V 的全部元素(本向量须为空且未持有堆空间)
     void copyFrom(T const* A, Rank lo, Rank hi); // 复制数组区间 A[lo, hi)
+    static void relocate(T* src, Rank n, T* dst); // 将 src[0, n) 移至未构造的 dst[0, n)
+    T* makeGap(Rank r, Rank k); // 在秩 r 处腾出 k 个未构造的空位
     void expand();    // 空间不足时扩容
-    void shrink();    // 装填因子过小时压缩
+    int truncate(Rank n); // 只保留前 n 个元素
     bool bubble(Rank lo, Rank hi); // 扫描交换
     void bubbleSort(Rank lo, Rank hi); // 起泡排序算法
     Rank max(Rank lo, Rank hi); // 选取最大元素
     void selectionSort(Rank lo, Rank hi); // 选择排序算法
-    void merge(Rank lo, Rank mi, Rank hi); // 归并算法
     void mergeSort(Rank lo, Rank hi); // 归并排序算法
     Rank partition(Rank lo, Rank hi); // 轴点构造算法
     void quickSort(Rank lo, Rank hi); // 快速排序算法
-    void heapSort(Rank lo, Rank hi); // 堆排序(稍后结合完全堆讲解)
+    void heapSort(Rank lo, Rank hi); // 堆排序
 
 public:
+    typedef Alloc allocator_type;
+
     // 构造函数
-    Vector(int c = DEFAULT_CAPACITY, int s = 0, T v = 0); // 容量为 c、规模为 s、所有元素初始为 v
-    Vector(T const* A, Rank n); // 数组整体复制
-    Vector(T const* A, Rank lo, Rank hi); // 区间复制
-    Vector(Vector<T> const& V); // 向量整体复制
-    Vector(Vector<T> const& V, Rank lo, Rank hi); // 向量区间复制
+    Vector(int c = INITIAL_CAPACITY, int s = 0, T const& v = T(), Alloc const& alloc = Alloc()); // 容量为 c、规模为 s、所有元素初始为 v
+    explicit Vector(Alloc const& alloc); // 使用指定分配器的空向量
+    Vector(T const* A, Rank n, Alloc const& alloc = Alloc()); // 数组整体复制
+    Vector(T const* A, Rank lo, Rank hi, Alloc const& alloc = Alloc()); // 区间复制
+    Vector(Vector const& V); // 向量整体复制
+    Vector(Vector const& V, Rank lo, Rank hi); // 向量区间复制
+    Vector(Vector&& V) noexcept; // 移动构造(接管数据区)
 
     // 析构函数
     ~Vector(); // 释放内部空间
@@ -48,20 +100,52 @@ public:
 
     Rank search(T const& e) const; // 有序向量整体查找
     Rank search(T const& e, Rank lo, Rank hi) const; // 有序向量区间查找
+    void search_many(Vector const& queries, Vector<Rank>& out) const; // 有序向量批量查找
+    dsa::SearchIndex<T> buildIndex() const; // 为有序向量构建静态查找索引
 
     // 可写访问接口
     T& operator[](Rank r) const; // 重载下标操作符，可以类似于数组形式引用各元素
-    Vector<T>& operator=(Vector<T> const&); // 重载赋值操作符，以便直接克隆向量
+    Vector& operator=(Vector const&); // 重载赋值操作符，以便直接克隆向量
+    Vector& operator=(Vector&&); // 移动赋值
+    Alloc get_allocator() const { return _alloc; } // 分配器
+    int capacity() const { return _capacity; } // 容量
+    void reserve(int n); // 预留空间，使容量至少为 n
+    void shrink_to_fit(); // 将容量收紧至规模
     T remove(Rank r); // 删除秩为 r 的元素
     int remove(Rank lo, Rank hi); // 删除秩在区间 [lo, hi) 之内的元素
     Rank insert(Rank r, T const& e); // 插入元素
+    Rank insert(Rank r, T&& e); // 插入元素(移动)
     Rank insert(T const& e); // 默认作为末元素插入
+    Rank insert(T&& e); // 默认作为末元素插入(移动)
+
+    // 区间操作：[first, last) 为迭代器区间，不得取自本向量；均至多重新分配一次
+    template <typename It, typename = typename std::enable_if<!std::is_integral<It>::value>::type>
+    Rank insert(Rank r, It first, It last); // 在秩 r 处插入区间
+    template <typename It, typename = typename std::enable_if<!std::is_integral<It>::value>::type>
+    void append(It first, It last); // 在末尾追加区间
+    template <typename It, typename = typename std::enable_if<!std::is_integral<It>::value>::type>
+    void assign(It first, It last); // 以区间替换全部内容
+    void assign(int n, T const& v); // 以 n 个 v 替换全部内容
+
+    template <typename... Args>
+    Rank emplace(Rank r, Args&&... args); // 在秩 r 处就地构造元素
+    template <typename... Args>
+    T& emplace_back(Args&&... args); // 在末尾就地构造元素
 
     void sort(Rank lo, Rank hi); // 对 [lo, hi) 排序
     void sort(); // 整体排序
+    void stableSort(Rank lo, Rank hi, int threads = 0); // 对 [lo, hi) 稳定排序(多线程)
+    void stableSort(int threads = 0); // 整体稳定排序
+    T& nth_element(Rank lo, Rank hi, Rank k); // 使 [lo, hi) 中秩为 k 的元素就位(内省选取)
+    T& nth_element(Rank k); // 使秩为 k 的元素就位，如 nth_element(size() * 99 / 100) 即 p99
+    T& nth_element(dsa::ParallelPolicy policy, Rank k); // 并行选取
+    void partial_sort(Rank k); // 使前 k 个元素为最小的 k 个且有序
     void unsort(Rank lo, Rank hi); // 对 [lo, hi) 置乱
+    void unsort(Rank lo, Rank hi, dsa::Random& rng); // 以指定发生器对 [lo, hi) 置乱
     void unsort(); // 整体置乱
+    void unsort(dsa::ParallelPolicy policy, std::uint64_t seed); // 整体并行置乱
     int deduplicate(); // 无序去重
+    int deduplicate(Rank budget); // 无序去重(散列表至多约 budget 项)
     int uniquify(); // 有序去重
 
     // 遍历
@@ -69,6 +153,18 @@ public:
     
     template <typename VST>
     void traverse(VST&); // 遍历(使用函数对象, 可全局性修改)
+
+    // 带执行策略的批量操作：policy 取 dsa::seq、dsa::par(线程池分块并行)或 dsa::unseq(可向量化)
+    template <typename Policy, typename VST>
+    void traverse(Policy const& policy, VST&& visit); // 遍历，各元素的访问须相互独立
+    template <typename Policy, typename F>
+    void transform(Policy const& policy, F&& f); // 各元素 e 替换为 f(e)
+    template <typename Policy, typename R, typename Op>
+    R reduce(Policy const& policy, R init, Op&& op) const; // 归约，op 须是 T 上满足结合律的二元运算(par 时 R 须即 T)
+    template <typename Policy, typename R, typename Op, typename Combine>
+    R reduce(Policy const& policy, R init, Op&& op, Combine&& combine) const; // 归约，op(R, T) 累积，combine(R, R) 合并各块，R() 为其单位元
+    template <typename Policy, typename Pred>
+    Rank count_if(Policy const& policy, Pred&& pred) const; // 满足 pred 的元素数
 }; // Vector
 
 #include "Vector.cpp" // 包含实现
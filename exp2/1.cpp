@@ -1,30 +1,9 @@
 #include <iostream>
 #include <vector>
-#include <stack>
 #include <algorithm>
 #include <cstdlib>
-#include <ctime>
-
-// 计算最大矩形面积的函数
-int largestRectangleArea(const std::vector<int>& heights) {
-    std::stack<int> indices;
-    int max_area = 0;
-    int n = heights.size();
-
-    for (int i = 0; i <= n; ++i) {
-        int current_height = (i == n) ? 0 : heights[i];
-        
-        while (!indices.empty() && heights[indices.top()] > current_height) {
-            int height = heights[indices.top()];
-            indices.pop();
-            int width = indices.empty() ? i : i - indices.top() - 1;
-            max_area = std::max(max_area, height * width);
-        }
-        indices.push(i);
-    }
-
-    return max_area;
-}
+#include "Histogram.h"
+#include "Grid.h"
 
 // 随机生成测试数据
 std::vector<int> generateRandomHeights(int n, int max_height) {
@@ -36,8 +15,8 @@ std::vector<int> generateRandomHeights(int n, int max_height) {
 }
 
 int main() {
-    // 设置随机种子
-    srand(static_cast<unsigned int>(time(0)));
+    // 固定随机种子，各次运行结果相同；计时见 rectangle_bench
+    srand(2024);
 
     // 测试示例
     std::vector<int> test1 = {2, 1, 5, 6, 2, 3};
@@ -51,10 +30,41 @@ int main() {
     for (int i = 0; i < 10; ++i) {
         int n = rand() % 100000 + 1; // 随机生成1到10^5之间的柱子数量
         std::vector<int> heights = generateRandomHeights(n, 10000); // 随机生成柱子的高度，范围为0到10^4
-        int area = largestRectangleArea(heights);
+        Area area = largestRectangleArea(heights);
         std::cout << "测试 " << (i + 1) << ": 最大面积 = " << area << std::endl;
     }
 
+    // 面积超出 int：高 10^4 的柱分段并行扫描，再把同一段重复送入流式扫描，共 10^9 根
+    std::vector<int> tall(1000000000 / 1000, 10000);
+    Area parallel = largestRectangleAreaParallel(tall);
+    RectangleScanner scanner;
+    for (int k = 0; k < 1000; ++k) scanner.push(tall.data(), tall.size());
+    std::cout << "10^6 根柱(并行): 最大面积 = " << parallel << std::endl;
+    std::cout << "10^9 根柱(流式): 最大面积 = " << scanner.area() << std::endl; // 10^13
+
+    // 占用栅格：整体载入后每次改动少数格子，只重算受影响的行，结果与重新载入对照
+    const int R = 1000, C = 1000;
+    std::vector<unsigned char> cells(R * C);
+    for (unsigned char& cell : cells) cell = rand() % 20 != 0; // 约 5% 的格被占用
+    OccupancyGrid grid(R, C);
+    grid.assign(cells.data());
+    Rect space = grid.largest();
+    std::cout << "栅格 " << R << "x" << C << ": 最大空闲矩形 " << space.height << "x" << space.width
+              << " 于 (" << space.top << ", " << space.left << ")" << std::endl;
+    for (int tick = 1; tick <= 5; ++tick) {
+        for (int k = 0; k < 10; ++k) {
+            int r = rand() % R, c = rand() % C;
+            bool free = rand() % 2 != 0;
+            cells[r * C + c] = free;
+            grid.set(r, c, free);
+        }
+        OccupancyGrid fresh(R, C);
+        fresh.assign(cells.data());
+        Area area = grid.largest().area();
+        std::cout << "改动 " << tick << ": 最大面积 = " << area
+                  << (area == fresh.largest().area() ? " (与重新载入一致)" : " (不一致)") << std::endl;
+    }
+
     return 0;
 }
 
@@ -0,0 +1,114 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "Expression.h"
+#include "VecMath.h"
+
+// 批量版的 calcu：对整块(VEC_BLOCK 个)操作数逐元素运算，结果写入 y
+// 只有前 m 个元素有效，除零等错误只就这 m 个检查；尾块其余位置的结果无意义
+// 与 execute 逐行求值相比：四则运算、'^' 与 '!' 结果逐位相同('p' 两边都反复平方)；
+// sin/cos/tan/log 用 VecMath 的逼近，与 std 函数至多相差 2 ulp(sin、cos)、4 ulp(tan)、1 ulp(log)
+inline void calcuBatch(const double* a, char op, const double* b, double* y, int m) {
+    switch (op) {
+        case '+': vecmath::add(a, b, y); break;
+        case '-': vecmath::sub(a, b, y); break;
+        case '*': vecmath::mul(a, b, y); break;
+        case '/':
+            if (vecmath::anyZero(b, m))
+                throw std::domain_error("Division by zero");
+            vecmath::div(a, b, y);
+            break;
+        case '^': // 与 calcu 同用 std::pow，结果与 execute 逐位相同
+            for (int i = 0; i < m; ++i) y[i] = calcu(a[i], '^', b[i]);
+            break;
+        default:
+            throw std::invalid_argument("Unknown operator");
+    }
+}
+
+inline void calcuBatch(char op, const double* a, double* y, int m) {
+    switch (op) {
+        case '!':
+            for (int i = 0; i < m; ++i) y[i] = calcu('!', a[i]);
+            break;
+        case 's': vecmath::sin(a, y); vecmath::trigFixup(op, a, y, m); break;
+        case 'c': vecmath::cos(a, y); vecmath::trigFixup(op, a, y, m); break;
+        case 't': vecmath::tan(a, y); vecmath::trigFixup(op, a, y, m); break;
+        case 'l': vecmath::log(a, y); vecmath::logFixup(a, y, m); break;
+        default:
+            throw std::invalid_argument("Unknown function");
+    }
+}
+
+// 列式批量求值：对 n 组变量取值各求一次 prog 的值
+// columns[k] 指向变量槽 k 的一列取值(共 n 个)，结果依次写入 out[0, n)
+// 按 VEC_BLOCK 行分块，块内逐条指令对整块运算，中间结果始终留在缓存中；
+// 变量直接引用输入列，常量预先展开为整块，均无需复制
+inline void executeBatch(const Program& prog, const double* const* columns, size_t n, double* out) {
+    if (prog.code.empty())
+        throw std::invalid_argument("Empty program");
+    size_t nvars = prog.vars.size(), nconsts = prog.consts.size(), nregs = prog.regs;
+    int depth = prog.depth > 0 ? prog.depth : 1;
+    std::vector<double> scratch((depth + 1 + nconsts + nvars + nregs) * VEC_BLOCK, 1.0);
+    std::vector<double*> buf(depth);                    // 各层中间结果的存放处
+    for (int k = 0; k < depth; ++k) buf[k] = scratch.data() + k * VEC_BLOCK;
+    double* spare = scratch.data() + depth * VEC_BLOCK; // 备用块：一元运算不原地进行，以便 fixup 读取原值
+    double* consts = spare + VEC_BLOCK;                 // 展开的常量
+    double* tail = consts + nconsts * VEC_BLOCK;        // 尾块中各变量的副本(以 1 补齐)
+    double* regs = tail + nvars * VEC_BLOCK;            // 寄存器
+    for (size_t k = 0; k < nconsts; ++k)
+        for (int i = 0; i < VEC_BLOCK; ++i) consts[k * VEC_BLOCK + i] = prog.consts[k];
+    std::vector<const double*> slot(depth); // 操作数栈：各层指向其数据所在
+
+    for (size_t r = 0; r < n; r += VEC_BLOCK) {
+        int m = n - r < size_t(VEC_BLOCK) ? static_cast<int>(n - r) : VEC_BLOCK;
+        if (m < VEC_BLOCK)
+            for (size_t k = 0; k < nvars; ++k)
+                std::memcpy(tail + k * VEC_BLOCK, columns[k] + r, sizeof(double) * m);
+        int top = -1;
+        for (const Instr& in : prog.code) {
+            switch (in.op) {
+                case '#': slot[++top] = consts + in.arg * VEC_BLOCK; break;
+                case '$':
+                    slot[++top] = m < VEC_BLOCK ? tail + in.arg * VEC_BLOCK : columns[in.arg] + r;
+                    break;
+                case 'L': slot[++top] = regs + in.arg * VEC_BLOCK; break;
+                case 'S': std::memcpy(regs + in.arg * VEC_BLOCK, slot[top], sizeof(double) * VEC_BLOCK); break;
+                case 'p':
+                    if (slot[top] == buf[top]) std::swap(buf[top], spare);
+                    vecmath::powInt(slot[top], in.arg, buf[top]);
+                    slot[top] = buf[top];
+                    break;
+                case '!': case 's': case 'c': case 't': case 'l': {
+                    if (slot[top] == buf[top]) std::swap(buf[top], spare);
+                    calcuBatch(in.op, slot[top], buf[top], m);
+                    slot[top] = buf[top];
+                    break;
+                }
+                default: {
+                    --top;
+                    double* y = buf[top];
+                    calcuBatch(slot[top], in.op, slot[top + 1], y, m);
+                    slot[top] = y;
+                }
+            }
+        }
+        std::memcpy(out + r, slot[0], sizeof(double) * m);
+    }
+}
+
+inline std::vector<double> executeBatch(const Program& prog, const std::vector<const double*>& columns, size_t n) {
+    if (columns.size() < prog.vars.size())
+        throw std::invalid_argument("Missing variable columns");
+    std::vector<double> out(n);
+    executeBatch(prog, columns.data(), n, out.data());
+    return out;
+}
+
+#endif // BATCH_H
@@ -0,0 +1,146 @@
+// 批量求值的校验：同一程序以 executeBatch 整列求值，与 execute 逐行求值的结果逐行比较
+// 四则运算、'^'、'!' 与优化后的程序('p'、寄存器)须逐位相同(NaN 视为相同)；
+// sin/cos/tan/log 走 VecMath 的逼近，与 std 函数之差不得超过各自的 ulp 上界
+// 输入含尾块(行数不是 VEC_BLOCK 的倍数)、三角函数的大参数与临近 pi/2 整数倍者、log 的非正数与非正规数等须经 fixup 的取值
+// 全部一致时返回 0，否则打印不一致之处并返回 1
+//
+// 用法：batch_check [--n 行数]
+
+#include <cmath>     // std::isnan, std::ldexp
+#include <cstdint>   // std::int64_t
+#include <cstdio>    // std::printf
+#include <cstdlib>   // std::atoll
+#include <cstring>   // std::memcpy, std::strcmp
+#include <limits>    // std::numeric_limits
+#include <random>    // std::mt19937_64
+#include <stdexcept> // std::domain_error
+#include <string>
+#include <vector>
+#include "Batch.h"
+#include "Expression.h"
+#include "Optimize.h"
+
+namespace {
+
+int failures = 0;
+
+// a 与 b 之间相隔的 double 个数；同为 NaN 或相等时为 0
+long long ulps(double a, double b) {
+    if (a == b || (std::isnan(a) && std::isnan(b))) return 0;
+    if (std::isnan(a) || std::isnan(b)) return std::numeric_limits<long long>::max();
+    std::int64_t x, y;
+    std::memcpy(&x, &a, sizeof x);
+    std::memcpy(&y, &b, sizeof y);
+    if (x < 0) x = std::numeric_limits<std::int64_t>::min() - x; // 负数翻转为单调的次序
+    if (y < 0) y = std::numeric_limits<std::int64_t>::min() - y;
+    return x > y ? x - y : y - x;
+}
+
+// 列式变量取值：x 为一般实数，y 为正数，k 为 0..25 的整数，w 含各种须经 fixup 的取值
+struct Columns {
+    std::vector<double> x, y, k, w;
+
+    explicit Columns(size_t n) : x(n), y(n), k(n), w(n) {
+        std::mt19937_64 rng(2024);
+        std::uniform_real_distribution<double> unit(0, 1);
+        double const special[] = {0.0, -0.0, -1.0, -1e-300, 5e-324, 1e-310, 1e10, -3e15, 1e300,
+                                  std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN(),
+                                  3.141592653589793, -314159.2653589793, 1.5707963267948966e8}; // 末三者临近 pi/2 的整数倍
+        int const nspecial = sizeof special / sizeof special[0];
+        for (size_t i = 0; i < n; ++i) {
+            x[i] = unit(rng) * 200 - 100;
+            y[i] = std::ldexp(unit(rng) + 0.5, static_cast<int>(rng() % 40) - 20);
+            k[i] = static_cast<double>(rng() % 26);
+            w[i] = i % 10 == 0 ? special[rng() % nspecial] : unit(rng) * 20 - 10;
+        }
+    }
+
+    // 按程序的变量槽号排列各列
+    std::vector<const double*> bind(Program const& prog) const {
+        std::vector<const double*> cols;
+        for (std::string const& name : prog.vars)
+            cols.push_back(name == "x" ? x.data() : name == "y" ? y.data() : name == "k" ? k.data() : w.data());
+        return cols;
+    }
+};
+
+// 逐行比较 executeBatch 与 execute，返回最大的 ulp 差
+long long compare(Program const& prog, Columns const& c, size_t n) {
+    std::vector<const double*> cols = c.bind(prog);
+    std::vector<double> batch = executeBatch(prog, cols, n);
+    std::vector<double> row(cols.size());
+    long long worst = 0;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t v = 0; v < cols.size(); ++v) row[v] = cols[v][i];
+        long long d = ulps(batch[i], execute(prog, row));
+        if (d > worst) worst = d;
+    }
+    return worst;
+}
+
+void checkExact(char const* expr, Columns const& c, size_t n) {
+    Program prog = compile(expr);
+    long long plain = compare(prog, c, n), optimized = compare(optimize(prog), c, n);
+    bool ok = plain == 0 && optimized == 0;
+    std::printf("%-28s %s\n", expr, ok ? "ok" : "FAILED");
+    if (!ok) ++failures;
+}
+
+void checkWithin(char const* expr, long long bound, Columns const& c, size_t n) {
+    long long worst = compare(compile(expr), c, n);
+    bool ok = worst <= bound;
+    std::printf("%-28s max %lld ulp (<= %lld) %s\n", expr, worst, bound, ok ? "ok" : "FAILED");
+    if (!ok) ++failures;
+}
+
+// 除零：两边都须抛出 std::domain_error
+void checkDomainError(char const* expr, Columns const& c, size_t n) {
+    Program prog = compile(expr);
+    bool batchThrew = false, rowThrew = false;
+    try {
+        executeBatch(prog, c.bind(prog), n);
+    } catch (std::domain_error const&) {
+        batchThrew = true;
+    }
+    try {
+        std::vector<double> row(prog.vars.size(), 1.0);
+        execute(prog, row);
+    } catch (std::domain_error const&) {
+        rowThrew = true;
+    }
+    bool ok = batchThrew && rowThrew;
+    std::printf("%-28s %s\n", expr, ok ? "ok" : "FAILED");
+    if (!ok) ++failures;
+}
+
+long long argValue(int argc, char** argv, char const* name, long long fallback) {
+    for (int i = 1; i + 1 < argc; ++i)
+        if (!std::strcmp(argv[i], name)) return std::atoll(argv[i + 1]);
+    return fallback;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t n = static_cast<size_t>(argValue(argc, argv, "--n", 10000));
+    Columns c(n);
+
+    checkExact("x+y*2-x/y", c, n);
+    checkExact("(x-y)*(x+y)/(y+1)", c, n);
+    checkExact("x^2+y^3-x^(0-3)", c, n);
+    checkExact("y^0.5+x^y", c, n);
+    checkExact("k!+(k+1)!/2^k", c, n);
+    checkExact("(x*y+1)*(x*y+1)-(y*x+1)", c, n);
+    checkExact("w*w-w/(w+2)", c, n);
+
+    checkWithin("sin(w)", 2, c, n);
+    checkWithin("cos(w)", 2, c, n);
+    checkWithin("tan(w)", 4, c, n);
+    checkWithin("log(w)", 1, c, n);
+    checkWithin("log(y)", 1, c, n);
+
+    checkDomainError("x/(k-k)", c, n);
+
+    std::printf("%zu rows: %s\n", n, failures ? "FAILED" : "batch and row-by-row results agree");
+    return failures ? 1 : 0;
+}
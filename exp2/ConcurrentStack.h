@@ -0,0 +1,140 @@
+#ifndef CONCURRENTSTACK_H
+#define CONCURRENTSTACK_H
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// 风险指针(hazard pointer)：线程在解引用共享结点前先将其登记，
+// 被摘下的结点只有在无人登记时才释放。结点地址因而不会在他人使用期间被重用，
+// CAS 的 ABA 问题随之消除
+namespace hazard {
+
+const int MAX_THREADS = 128; // 可同时使用风险指针的线程数上限
+
+struct alignas(64) Slot { // 独占一条缓存行，避免伪共享
+    std::atomic<void*> ptr{nullptr};
+    std::atomic<bool> used{false};
+};
+
+inline Slot slots[MAX_THREADS];
+
+// 当前线程的风险指针：首次使用时认领一个空闲槽位，线程结束时归还
+inline std::atomic<void*>& local() {
+    struct Owner {
+        Slot* slot = nullptr;
+        Owner() {
+            for (Slot& s : slots)
+                if (!s.used.load(std::memory_order_relaxed) && !s.used.exchange(true, std::memory_order_acquire)) {
+                    slot = &s;
+                    return;
+                }
+            throw std::runtime_error("hazard: too many threads");
+        }
+        ~Owner() {
+            slot->ptr.store(nullptr, std::memory_order_release);
+            slot->used.store(false, std::memory_order_release);
+        }
+    };
+    thread_local Owner owner;
+    return owner.slot->ptr;
+}
+
+// 已摘下、待释放的结点
+struct Retired {
+    void* ptr;
+    void (*destroy)(void*);
+};
+
+// 释放 list 中未被任何线程登记的结点
+inline void scan(std::vector<Retired>& list) {
+    std::vector<void*> guarded;
+    for (Slot& s : slots)
+        if (void* p = s.ptr.load(std::memory_order_seq_cst)) guarded.push_back(p);
+    std::sort(guarded.begin(), guarded.end());
+    size_t kept = 0;
+    for (Retired& r : list) {
+        if (std::binary_search(guarded.begin(), guarded.end(), r.ptr)) list[kept++] = r;
+        else r.destroy(r.ptr);
+    }
+    list.resize(kept);
+}
+
+// 当前线程的待释放结点：积累到一定数量时统一扫描；线程结束时全部释放
+inline void retire(void* ptr, void (*destroy)(void*)) {
+    struct List {
+        std::vector<Retired> nodes;
+        ~List() {
+            while (!nodes.empty()) { // 他人只在出栈的瞬间持有风险指针，稍候即可释放
+                scan(nodes);
+                if (!nodes.empty()) std::this_thread::yield();
+            }
+        }
+    };
+    thread_local List list;
+    list.nodes.push_back(Retired{ptr, destroy});
+    if (list.nodes.size() >= 2 * MAX_THREADS) scan(list.nodes);
+}
+
+} // namespace hazard
+
+// 无锁栈(Treiber)：栈顶为原子指针，入栈与出栈各以一次 CAS 完成；
+// 出栈前以风险指针保护栈顶结点，结点延迟释放
+template <typename T>
+class ConcurrentStack {
+    struct Node {
+        T value;
+        Node* next;
+    };
+    std::atomic<Node*> head;
+
+    static void destroy(void* p) { delete static_cast<Node*>(p); }
+
+public:
+    ConcurrentStack() : head(nullptr) {}
+    ~ConcurrentStack() { // 析构时不得再有其他线程访问
+        Node* p = head.load(std::memory_order_relaxed);
+        while (p) {
+            Node* next = p->next;
+            delete p;
+            p = next;
+        }
+    }
+    ConcurrentStack(const ConcurrentStack&) = delete;
+    ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+
+    // 是否为空(并发修改时仅为瞬时结果)
+    bool IsEmpty() const { return head.load(std::memory_order_acquire) == nullptr; }
+
+    void Push(const T& x) { Emplace(x); }
+    void Push(T&& x) { Emplace(std::move(x)); }
+
+    template <typename... Args>
+    void Emplace(Args&&... args) {
+        Node* node = new Node{T(std::forward<Args>(args)...), head.load(std::memory_order_relaxed)};
+        while (!head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    // 弹出栈顶元素存入 x；栈空时返回 false
+    bool TryPop(T& x) {
+        std::atomic<void*>& hp = hazard::local();
+        Node* top;
+        for (;;) {
+            top = head.load(std::memory_order_acquire);
+            if (!top) return false;
+            hp.store(top, std::memory_order_seq_cst);
+            if (head.load(std::memory_order_seq_cst) != top) continue; // 登记前已被摘下，重试
+            if (head.compare_exchange_strong(top, top->next, std::memory_order_acq_rel, std::memory_order_acquire))
+                break;
+        }
+        hp.store(nullptr, std::memory_order_release);
+        x = std::move(top->value);
+        hazard::retire(top, destroy);
+        return true;
+    }
+};
+
+#endif // CONCURRENTSTACK_H
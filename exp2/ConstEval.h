@@ -0,0 +1,113 @@
+#ifndef CONSTEVAL_H
+#define CONSTEVAL_H
+
+#include <stdexcept>
+#include <string_view>
+#include "Expression.h"
+
+// 编译期求值：算符优先分析直接求值(不生成程序)，与 compile() 共用优先级表、readNumber、functionCode 与 calcu
+// 在常量表达式中使用时，结果为编译期常量，语法错误、除零等 throw 成为编译错误；
+// 对运行时的字符串照常调用即可，错误时抛出 std::invalid_argument / std::domain_error
+//
+//     constexpr double TWO_PI = evaluateLiteral("2*3.14159265358979");
+//     double r = evaluateLiteral(line);           // 运行时
+//
+// 字面量中不能有变量；运算符栈与操作数栈为定长的 CONST_EVAL_DEPTH，括号嵌套过深时抛出 std::length_error
+
+constexpr int CONST_EVAL_DEPTH = 256;
+
+// 定长栈：无动态分配，可用于常量表达式
+template <typename T>
+struct ConstStack {
+    T values[CONST_EVAL_DEPTH] = {};
+    int top = -1;
+
+    constexpr bool IsEmpty() const { return top == -1; }
+    constexpr T& Top() {
+        if (IsEmpty()) throw std::out_of_range("Stack is empty");
+        return values[top];
+    }
+    constexpr void Push(T x) {
+        if (top + 1 == CONST_EVAL_DEPTH) throw std::length_error("Expression nested too deeply");
+        values[++top] = x;
+    }
+    constexpr T Pop() {
+        if (IsEmpty()) throw std::out_of_range("Stack is empty");
+        return values[top--];
+    }
+};
+
+constexpr double evaluateLiteral(std::string_view expr) {
+    ConstStack<double> opnd; // 操作数栈
+    ConstStack<char> optr;   // 运算符栈
+    ConstStack<char> call;   // 与运算符栈中的各 '(' 对应：函数调用为函数名，普通括号为 0
+    optr.Push('\0');
+    bool operand = true;     // 下一个记号是否应为操作数
+    const char* begin = expr.data();
+    const char* end = begin + expr.size();
+    const char* s = begin;
+
+    for (;;) {
+        while (s < end && (*s == ' ' || *s == '\t')) s++;
+        char c = s < end ? *s : '\0';
+        if (operand) {
+            if ((c >= '0' && c <= '9') || c == '.') {
+                opnd.Push(readNumber(s, end));
+                operand = false;
+            } else if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_') {
+                const char* first = s;
+                while (s < end && ((*s >= 'a' && *s <= 'z') || (*s >= 'A' && *s <= 'Z') || (*s >= '0' && *s <= '9') || *s == '_'))
+                    s++;
+                std::string_view name(first, s - first);
+                while (s < end && (*s == ' ' || *s == '\t')) s++;
+                if (s == end || *s != '(')
+                    syntaxError("Unbound variable", first - begin);
+                optr.Push('(');
+                call.Push(functionCode(name));
+                s++;
+            } else if (c == '(') {
+                optr.Push('(');
+                call.Push(0);
+                s++;
+            } else {
+                syntaxError("Operand expected", s - begin);
+            }
+            continue;
+        }
+        if (optrIndex(c) < 0 || c == '(')
+            syntaxError("Operator expected", s - begin);
+        switch (getPriority(optr.Top(), c)) {
+            case '<':
+                optr.Push(c);
+                if (c != '!') operand = true;
+                s++;
+                break;
+
+            case '>': {
+                char op = optr.Pop();
+                if (op == '!') {
+                    opnd.Top() = calcu('!', opnd.Top());
+                } else {
+                    double b = opnd.Pop();
+                    opnd.Top() = calcu(opnd.Top(), op, b);
+                }
+                break;
+            }
+
+            case '=':
+                optr.Pop();
+                if (!c) return opnd.Pop(); // 表达式结束
+                {
+                    char func = call.Pop();
+                    if (func) opnd.Top() = calcu(func, opnd.Top());
+                }
+                s++;
+                break;
+
+            default:
+                syntaxError("Unbalanced parentheses", s - begin);
+        }
+    }
+}
+
+#endif // CONSTEVAL_H
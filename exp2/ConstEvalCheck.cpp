@@ -0,0 +1,87 @@
+// 编译期求值的校验：evaluateLiteral 的结果在编译期以 static_assert 核对(本文件能编译即已通过)，
+// 运行时再逐个与 evaluate(compile + execute)比较，出错的字面量两边须抛出同类异常
+// sin/cos/tan/log 与非整数次幂只有 GCC 能在编译期求值，其他编译器上只做运行时的比较
+// 全部一致时返回 0，否则打印不一致之处并返回 1
+//
+// 用法：const_eval_check
+
+#include <cstdio>    // std::printf
+#include <cstring>   // std::memcmp
+#include <limits>    // std::numeric_limits
+#include <stdexcept> // std::invalid_argument, std::domain_error, std::length_error
+#include <string>
+#include "ConstEval.h"
+#include "Expression.h"
+
+static_assert(evaluateLiteral("1+2*3") == 7, "precedence");
+static_assert(evaluateLiteral("(1+2)*3") == 9, "parentheses");
+static_assert(evaluateLiteral(" 7 / 2 - 0.5 ") == 3, "blanks and division");
+static_assert(evaluateLiteral("0.1+0.2") == 0.1 + 0.2, "decimal literals round like the compiler's");
+static_assert(evaluateLiteral("5!") == 120, "factorial");
+static_assert(evaluateLiteral("3!!") == 720, "repeated factorial");
+static_assert(evaluateLiteral("2*3!") == 12, "factorial binds tighter than *");
+static_assert(evaluateLiteral("170!") == FACTORIALS[170], "largest finite factorial");
+static_assert(evaluateLiteral("171!") == std::numeric_limits<double>::infinity(), "factorial overflow");
+
+#if defined(__GNUC__) && !defined(__clang__)
+static_assert(evaluateLiteral("2^10") == 1024, "power");
+static_assert(evaluateLiteral("2^0.5") == 1.4142135623730951, "non-integer power");
+static_assert(evaluateLiteral("sin(0)+cos(0)+tan(0)") == 1, "trigonometric functions");
+static_assert(evaluateLiteral("log(1)+l(1)") == 0, "log and its short name");
+#endif
+
+namespace {
+
+int failures = 0;
+
+// 求值 expr；出错时结果为 NaN，error 记下异常的种类
+double run(double (*eval)(std::string const&), std::string const& expr, int& error) {
+    error = 0;
+    try {
+        return eval(expr);
+    } catch (std::length_error const&) {
+        error = 3;
+    } catch (std::domain_error const&) {
+        error = 2;
+    } catch (std::invalid_argument const&) {
+        error = 1;
+    }
+    return std::numeric_limits<double>::quiet_NaN();
+}
+
+double literal(std::string const& expr) { return evaluateLiteral(expr); }
+double runtime(std::string const& expr) { return evaluate(expr); }
+
+// 运行时比较：结果逐位相同，或两边抛出同类异常
+void check(std::string const& expr) {
+    int e1, e2;
+    double a = run(literal, expr, e1), b = run(runtime, expr, e2);
+    bool ok = e1 == e2 && (e1 || std::memcmp(&a, &b, sizeof a) == 0);
+    std::printf("%-28s %s\n", expr.c_str(), ok ? "ok" : "FAILED");
+    if (!ok) ++failures;
+}
+
+// 只有 evaluateLiteral 受定长栈所限：嵌套过深时须抛出 std::length_error
+void checkTooDeep() {
+    std::string expr = std::string(CONST_EVAL_DEPTH, '(') + "1" + std::string(CONST_EVAL_DEPTH, ')');
+    int error;
+    run(literal, expr, error);
+    bool ok = error == 3;
+    std::printf("%-28s %s\n", "nesting > CONST_EVAL_DEPTH", ok ? "ok" : "FAILED");
+    if (!ok) ++failures;
+}
+
+} // namespace
+
+int main() {
+    char const* const cases[] = {
+        "1+2*3", "(1+2)*3", " 7 / 2 - 0.5 ", "0.1+0.2", "5!", "3!!", "2*3!", "170!", "171!",
+        "2^10", "2^0.5", "sin(0)+cos(0)+tan(0)", "log(1)+l(1)", "sin(1)*cos(2)/tan(3)", "log(10)^3",
+        "123456789012345678901234567890", "0.000000000000000000000000123", "3.7!",
+        "1/0", "(0-1)!", "1+", "x+1", "((1)", "1)", "foo(1)", "1..2", "",
+    };
+    for (char const* expr : cases) check(expr);
+    checkTooDeep();
+    std::printf("%s\n", failures ? "FAILED" : "compile-time and runtime evaluation agree");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,360 @@
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Stack.h"
+
+// 以下运算符表、阶乘、calcu、readNumber 等均为 constexpr，编译期求值(ConstEval.h)与运行时共用；
+// 出错时的 throw 在编译期求值中即成为编译错误
+
+// 运算符优先级表
+constexpr int N_OPTR = 9;
+constexpr char pri[N_OPTR][N_OPTR] = {
+    {'>', '>', '<', '<', '<', '<', '<', '>', '>'},
+    {'>', '>', '<', '<', '<', '<', '<', '>', '>'},
+    {'>', '>', '>', '>', '<', '<', '<', '>', '>'},
+    {'>', '>', '>', '>', '<', '<', '<', '>', '>'},
+    {'>', '>', '>', '>', '>', '<', '<', '>', '>'},
+    {'>', '>', '>', '>', '>', '>', ' ', '>', '>'},
+    {'<', '<', '<', '<', '<', '<', '<', '=', ' '},
+    {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
+    {'<', '<', '<', '<', '<', '<', '<', ' ', '='}
+};
+
+constexpr int optrIndex(char op) {
+    switch (op) {
+        case '+': return 0;
+        case '-': return 1;
+        case '*': return 2;
+        case '/': return 3;
+        case '^': return 4;
+        case '!': return 5;
+        case '(': return 6;
+        case ')': return 7;
+        case '\0': return 8;
+        default: return -1;
+    }
+}
+
+constexpr char getPriority(char topOp, char currentOp) {
+    int i = optrIndex(topOp);
+    int j = optrIndex(currentOp);
+    if (i == -1 || j == -1)
+        throw std::invalid_argument("错误的运算符");
+    return pri[i][j];
+}
+
+// 阶乘：0! 至 170! 预先逐项连乘制表，171! 起超出 double 范围
+constexpr int MAX_FACTORIAL = 170;
+
+constexpr std::array<double, MAX_FACTORIAL + 1> factorialTable() {
+    std::array<double, MAX_FACTORIAL + 1> t{};
+    t[0] = 1;
+    for (int i = 1; i <= MAX_FACTORIAL; ++i) t[i] = t[i - 1] * i;
+    return t;
+}
+
+inline constexpr std::array<double, MAX_FACTORIAL + 1> FACTORIALS = factorialTable();
+
+constexpr double factorial(int n) {
+    if (n < 0)
+        throw std::domain_error("Negative factorial");
+    return n <= MAX_FACTORIAL ? FACTORIALS[n] : std::numeric_limits<double>::infinity();
+}
+
+constexpr double calcu(double operand1, char op, double operand2 = 0) {
+    switch (op) {
+        case '+': return operand1 + operand2;
+        case '-': return operand1 - operand2;
+        case '*': return operand1 * operand2;
+        case '/':
+            if (operand2 == 0)
+                throw std::domain_error("Division by zero");
+            return operand1 / operand2;
+        case '^': return std::pow(operand1, operand2);
+        default:
+            throw std::invalid_argument("Unknown operator");
+    }
+}
+
+// x^k，k 为整数：反复平方，k = 2 时即 x * x
+constexpr double powInt(double x, long long k) {
+    unsigned long long e = k < 0 ? 0ull - static_cast<unsigned long long>(k) : static_cast<unsigned long long>(k);
+    double y = 1;
+    for (; e; e >>= 1) {
+        if (e & 1) y *= x;
+        if (e > 1) x *= x;
+    }
+    return k < 0 ? 1 / y : y;
+}
+
+// sin/cos/tan/log 与非整数次幂调用 std 函数：GCC 可在编译期求得其值，其他编译器上只能在运行时求值
+constexpr double calcu(char op, double operand) {
+    switch (op) {
+        case '!':
+            return factorial(static_cast<int>(operand));
+        case 's': // sin
+            return std::sin(operand);
+        case 'c': // cos
+            return std::cos(operand);
+        case 't': // tan
+            return std::tan(operand);
+        case 'l': // log
+            return std::log(operand);
+        default:
+            throw std::invalid_argument("Unknown function");
+    }
+}
+
+constexpr double POW10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// [begin, end) 中的实数，交由 std::from_chars，正确舍入
+inline double parseNumber(const char* begin, const char* end) {
+    double num;
+    std::from_chars_result r = std::from_chars(begin, end, num);
+    if (r.ec == std::errc::result_out_of_range) { // 首个非零数字在小数点之后时为下溢，取 0；否则上溢为无穷大
+        const char* lead = std::find_if(begin, end, [](char c) { return c >= '1' && c <= '9'; });
+        return std::find(begin, lead, '.') != lead ? 0.0 : HUGE_VAL;
+    }
+    if (r.ec != std::errc() || r.ptr != end)
+        throw std::invalid_argument("Malformed number");
+    return num;
+}
+
+// 读入一个无符号实数，s 随之后移(至多到 end)；第二个小数点不属于该数
+// 有效数字累积于 64 位整数 w，值为 w / 10^k：w <= 2^53 且 k <= 22 时二者都能由 double 精确表示，
+// 一次除法即得正确舍入的结果(Clinger)；有效数字过多或小数位过长时交由 parseNumber(不能在编译期求值)
+constexpr double readNumber(const char*& s, const char* end) {
+    const char* begin = s;
+    std::uint64_t w = 0;
+    int digits = 0;  // w 中的有效数字位数
+    int scale = 0;   // w 中的小数位数
+    bool hasDecimal = false, hasDigit = false, exact = true;
+    for (; s < end; ++s) {
+        if (*s == '.') {
+            if (hasDecimal) break;
+            hasDecimal = true;
+        } else if (*s >= '0' && *s <= '9') {
+            hasDigit = true;
+            if (digits == 19) { // 再多一位可能溢出
+                exact = false;
+                continue;
+            }
+            if (w || *s != '0') ++digits;
+            w = w * 10 + (*s - '0');
+            if (hasDecimal) ++scale;
+        } else {
+            break;
+        }
+    }
+    if (!hasDigit)
+        throw std::invalid_argument("Malformed number");
+    if (exact && w <= (std::uint64_t(1) << 53) && scale <= 22)
+        return static_cast<double>(w) / POW10[scale];
+    return parseNumber(begin, s);
+}
+
+// 语法错误：what 附上出错位置
+[[noreturn]] inline void syntaxError(const char* what, std::ptrdiff_t position) {
+    throw std::invalid_argument(std::string(what) + " at position " + std::to_string(position));
+}
+
+// 编译所得的后缀式(RPN)程序：每条指令为一个运算符或一次入栈
+//   '#' 常量 consts[arg] 入栈    '$' 变量 vars[arg] 入栈
+//   '+' '-' '*' '/' '^'          弹出两个操作数，结果入栈
+//   '!' 's' 'c' 't' 'l'          阶乘与函数，作用于栈顶
+// 以下只由优化(Optimize.h)产生：
+//   'p' 栈顶的 arg 次整数幂      'S' 栈顶存入寄存器 arg(不出栈)    'L' 寄存器 arg 入栈
+struct Instr {
+    char op;
+    int arg;
+};
+
+struct Program {
+    std::vector<Instr> code;
+    std::vector<double> consts;     // 常量池
+    std::vector<std::string> vars;  // 变量名，下标即执行时的变量槽号
+    int depth = 0;                  // 执行时操作数栈的最大深度
+    int regs = 0;                   // 执行时所需的寄存器数
+
+    // 变量 name 的槽号，不存在时返回 -1
+    int variable(std::string_view name) const {
+        for (size_t i = 0; i < vars.size(); ++i)
+            if (vars[i] == name) return static_cast<int>(i);
+        return -1;
+    }
+};
+
+// 函数名对应的运算符：s(...) 与 sin(...) 等价，依此类推
+constexpr char functionCode(std::string_view name) {
+    if (name == "s" || name == "sin") return 's';
+    if (name == "c" || name == "cos") return 'c';
+    if (name == "t" || name == "tan") return 't';
+    if (name == "l" || name == "log") return 'l';
+    throw std::invalid_argument("Unknown function: " + std::string(name));
+}
+
+// 编译：按优先级表做一趟算符优先分析，原本的求值动作改为输出指令
+// 标识符后紧跟 '(' 时为函数调用，否则为变量；语法错误时抛出 std::invalid_argument
+// 源串为 [begin, end)，无需以 '\0' 结尾；prog 原有内容被清除但保留其空间，运算符栈为线程局部的，
+// 逐行编译大量表达式时不再反复分配
+inline void compile(const char* begin, const char* end, Program& prog) {
+    thread_local Stack<char> optr; // 运算符栈
+    thread_local Stack<char> call; // 与运算符栈中的各 '(' 对应：函数调用为函数名，普通括号为 0
+    optr.Clear();
+    call.Clear();
+    prog.code.clear();
+    prog.consts.clear();
+    prog.vars.clear();
+    prog.depth = 0;
+    prog.regs = 0;
+    optr.Push('\0');
+    int depth = 0;
+    bool operand = true; // 下一个记号是否应为操作数
+    const char* s = begin;
+
+    auto peek = [&] { return s < end ? *s : '\0'; };
+    auto blank = [&] { while (s < end && (*s == ' ' || *s == '\t')) s++; };
+    auto emit = [&](char op, int arg) {
+        prog.code.push_back(Instr{op, arg});
+        if (op == '#' || op == '$') {
+            if (++depth > prog.depth) prog.depth = depth;
+        } else if (optrIndex(op) >= 0 && op != '!') {
+            --depth;
+        }
+    };
+    auto error = [&](const char* what) { syntaxError(what, s - begin); };
+
+    for (;;) {
+        blank();
+        char c = peek();
+        if (operand) {
+            if (isdigit(static_cast<unsigned char>(c)) || (c == '.')) {
+                prog.consts.push_back(readNumber(s, end));
+                emit('#', static_cast<int>(prog.consts.size()) - 1);
+                operand = false;
+            } else if (isalpha(static_cast<unsigned char>(c)) || (c == '_')) {
+                const char* first = s;
+                while (s < end && (isalnum(static_cast<unsigned char>(*s)) || (*s == '_'))) s++;
+                std::string_view name(first, s - first);
+                blank();
+                if (peek() == '(') { // 函数调用
+                    char func = functionCode(name);
+                    optr.Push('(');
+                    call.Push(func);
+                    s++;
+                } else { // 变量
+                    int slot = prog.variable(name);
+                    if (slot < 0) {
+                        slot = static_cast<int>(prog.vars.size());
+                        prog.vars.emplace_back(name);
+                    }
+                    emit('$', slot);
+                    operand = false;
+                }
+            } else if (c == '(') {
+                optr.Push('(');
+                call.Push(0);
+                s++;
+            } else {
+                error("Operand expected");
+            }
+            continue;
+        }
+        if (optrIndex(c) < 0 || c == '(')
+            error("Operator expected");
+        switch (getPriority(optr.Top(), c)) {
+            case '<':
+                optr.Push(c);
+                if (c != '!') operand = true;
+                s++;
+                break;
+
+            case '>':
+                emit(optr.Pop(), 0);
+                break;
+
+            case '=':
+                optr.Pop();
+                if (!c) return; // 表达式结束
+                {
+                    char func = call.Pop();
+                    if (func) emit(func, 0);
+                }
+                s++;
+                break;
+
+            default:
+                error("Unbalanced parentheses");
+        }
+    }
+}
+
+inline Program compile(const std::string& expr) {
+    Program prog;
+    compile(expr.c_str(), expr.c_str() + expr.size(), prog);
+    return prog;
+}
+
+// 执行：在 vars(按槽号排列的变量值)上运行程序；不做语法分析，深度不大时也不分配内存
+// 空程序(未经 compile 的 Program)没有结果，抛出 std::invalid_argument
+inline double execute(const Program& prog, const double* vars) {
+    if (prog.code.empty())
+        throw std::invalid_argument("Empty program");
+    const int LOCAL_DEPTH = 64;
+    double local[LOCAL_DEPTH];
+    std::vector<double> heap;
+    double* opnd = local; // 操作数栈，其后为寄存器
+    if (prog.depth + prog.regs > LOCAL_DEPTH) {
+        heap.resize(prog.depth + prog.regs);
+        opnd = heap.data();
+    }
+    double* regs = opnd + prog.depth;
+    int top = -1;
+    for (const Instr& in : prog.code) {
+        switch (in.op) {
+            case '#': opnd[++top] = prog.consts[in.arg]; break;
+            case '$': opnd[++top] = vars[in.arg]; break;
+            case 'L': opnd[++top] = regs[in.arg]; break;
+            case 'S': regs[in.arg] = opnd[top]; break;
+            case 'p': opnd[top] = powInt(opnd[top], in.arg); break;
+            case '!': case 's': case 'c': case 't': case 'l':
+                opnd[top] = calcu(in.op, opnd[top]);
+                break;
+            default:
+                --top;
+                opnd[top] = calcu(opnd[top], in.op, opnd[top + 1]);
+        }
+    }
+    return opnd[0];
+}
+
+inline double execute(const Program& prog, const std::vector<double>& vars) {
+    if (vars.size() < prog.vars.size())
+        throw std::invalid_argument("Missing variable values");
+    return execute(prog, vars.data());
+}
+
+// 一次性求值(不含变量的表达式)
+inline double evaluate(const std::string& expr) {
+    Program prog = compile(expr);
+    if (!prog.vars.empty())
+        throw std::invalid_argument("Unbound variable: " + prog.vars[0]);
+    return execute(prog, nullptr);
+}
+
+#endif // EXPRESSION_H
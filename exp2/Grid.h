@@ -0,0 +1,176 @@
+#ifndef GRID_H
+#define GRID_H
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "Histogram.h"
+
+// 占用栅格中的最大空闲矩形：以每一行为底，该行各列向上连续空闲的格数构成一个柱状图，
+// 各行柱状图中最大矩形的最大者即为所求
+//
+// 只保存各格的柱高(0 即占用)，空闲与否由此可知。整体载入时按行分带，各线程处理一带：
+// 先求各带底部的连续空闲格数，逐带相接得到每带上方的柱高，然后逐行求柱高并随即扫描该行，
+// 一行的数据在缓存中只过一遍。
+// 单格改动时，只有该列自此向下连续空闲的各行柱高改变；这些行记为待重算，查询时才重新扫描
+
+struct Rect {
+    int top, left, height, width; // 左上角与尺寸(格)
+    Area area() const { return static_cast<Area>(height) * width; }
+};
+
+// 一行柱状图中的最大矩形(底边在 row 行)；stack 为调用者提供的工作空间
+inline Rect largestRectangleInRow(const int* heights, int n, int row, std::vector<Bar>& stack) {
+    Area best = 0;
+    Bar bestBar{0, 0};
+    long long bestEnd = 0;
+    stack.clear();
+    stack.push_back(Bar{-1, 0}); // 哨兵：低于任何柱，省去判空
+    for (int i = 0; i <= n; ++i) {
+        int h = i < n ? heights[i] : 0; // 行末以高 0 的柱弹出全部
+        if (stack.back().height == h) continue;
+        long long start = i;
+        while (stack.back().height >= h) {
+            const Bar& b = stack.back();
+            Area a = static_cast<Area>(b.height) * (i - b.start);
+            if (a > best) {
+                best = a;
+                bestBar = b;
+                bestEnd = i;
+            }
+            start = b.start;
+            stack.pop_back();
+        }
+        stack.push_back(Bar{h, start});
+    }
+    if (best == 0) return Rect{row, 0, 0, 0};
+    return Rect{row - bestBar.height + 1, static_cast<int>(bestBar.start), bestBar.height, static_cast<int>(bestEnd - bestBar.start)};
+}
+
+class OccupancyGrid {
+public:
+    OccupancyGrid(int rows, int cols)
+        : nrows(checked(rows)), ncols(checked(cols)), heights(static_cast<size_t>(rows) * cols, 0), rowBest(rows, Rect{0, 0, 0, 0}), isDirty(rows, 0) {
+        for (int r = 0; r < rows; ++r) rowBest[r].top = r;
+    }
+
+    int rows() const { return nrows; }
+    int cols() const { return ncols; }
+    bool isFree(int r, int c) const { return at(r, c) > 0; }
+    const int* rowHeights(int r) const { return &heights[static_cast<size_t>(r) * ncols]; }
+
+    // 整体载入：cells 按行存放，非 0 为空闲
+    void assign(const unsigned char* cells, int threads = 0);
+    // 改动一格；受影响的行待查询时重算
+    void set(int r, int c, bool free);
+    // 最大空闲矩形(面积为 0 时表示没有空闲格)
+    Rect largest(int threads = 0);
+
+private:
+    int nrows, ncols;
+    std::vector<int> heights;  // 各格向上连续空闲的格数，按行存放
+    std::vector<Rect> rowBest; // 各行柱状图中的最大矩形
+    std::vector<int> dirty;    // 待重算的行
+    std::vector<char> isDirty;
+
+    // 尺寸须在分配各数组之前检查(成员按声明次序初始化，nrows、ncols 在前)，负数转为 size_t 即成巨大的长度
+    static int checked(int n) {
+        if (n < 0) throw std::invalid_argument("Negative grid size");
+        return n;
+    }
+    int& at(int r, int c) { return heights[static_cast<size_t>(r) * ncols + c]; }
+    int at(int r, int c) const { return heights[static_cast<size_t>(r) * ncols + c]; }
+    void markDirty(int r) {
+        if (!isDirty[r]) {
+            isDirty[r] = 1;
+            dirty.push_back(r);
+        }
+    }
+    void check(int r, int c) const {
+        if (r < 0 || r >= nrows || c < 0 || c >= ncols) throw std::out_of_range("Cell out of grid");
+    }
+    static int workers(int threads, long long tasks) {
+        if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        return static_cast<int>(std::max(1LL, std::min<long long>(threads, tasks)));
+    }
+    // 在 parts 个线程上执行 f(0) .. f(parts - 1)
+    template <typename F>
+    static void parallel(int parts, F f) {
+        if (parts == 1) return f(0);
+        std::vector<std::thread> pool;
+        for (int p = 0; p < parts; ++p) pool.emplace_back(f, p);
+        for (std::thread& t : pool) t.join();
+    }
+};
+
+inline void OccupancyGrid::assign(const unsigned char* cells, int threads) {
+    const int MIN_BAND = 16; // 每带至少的行数
+    int bands = workers(threads, nrows / MIN_BAND);
+    std::vector<int> first(bands + 1);
+    for (int b = 0; b <= bands; ++b) first[b] = static_cast<int>(static_cast<long long>(nrows) * b / bands);
+
+    // 各带底部向上连续空闲的格数(整列空闲时等于带高)
+    std::vector<int> run(static_cast<size_t>(bands) * ncols);
+    parallel(bands, [&](int b) {
+        int* bottom = &run[static_cast<size_t>(b) * ncols];
+        for (int c = 0; c < ncols; ++c) bottom[c] = 0;
+        for (int r = first[b]; r < first[b + 1]; ++r) {
+            const unsigned char* row = cells + static_cast<size_t>(r) * ncols;
+            for (int c = 0; c < ncols; ++c) bottom[c] = row[c] ? bottom[c] + 1 : 0;
+        }
+    });
+    // 逐带相接：carry[b] 为第 b 带上方一行的柱高
+    std::vector<int> carry(static_cast<size_t>(bands) * ncols, 0);
+    for (int b = 1; b < bands; ++b) {
+        const int* above = &carry[static_cast<size_t>(b - 1) * ncols];
+        const int* bottom = &run[static_cast<size_t>(b - 1) * ncols];
+        int* cur = &carry[static_cast<size_t>(b) * ncols];
+        int height = first[b] - first[b - 1];
+        for (int c = 0; c < ncols; ++c) cur[c] = bottom[c] == height ? above[c] + height : bottom[c];
+    }
+    parallel(bands, [&](int b) {
+        std::vector<Bar> stack;
+        const int* prev = &carry[static_cast<size_t>(b) * ncols];
+        for (int r = first[b]; r < first[b + 1]; ++r) {
+            const unsigned char* row = cells + static_cast<size_t>(r) * ncols;
+            int* h = &heights[static_cast<size_t>(r) * ncols];
+            for (int c = 0; c < ncols; ++c) h[c] = row[c] ? prev[c] + 1 : 0;
+            rowBest[r] = largestRectangleInRow(h, ncols, r, stack);
+            prev = h;
+        }
+    });
+    dirty.clear();
+    isDirty.assign(nrows, 0);
+}
+
+inline void OccupancyGrid::set(int r, int c, bool free) {
+    check(r, c);
+    if (isFree(r, c) == free) return;
+    at(r, c) = free ? (r > 0 ? at(r - 1, c) : 0) + 1 : 0;
+    markDirty(r);
+    for (int k = r + 1; k < nrows && at(k, c) > 0; ++k) { // 其下连续的空闲格随之改变，遇占用格为止
+        at(k, c) = at(k - 1, c) + 1;
+        markDirty(k);
+    }
+}
+
+inline Rect OccupancyGrid::largest(int threads) {
+    if (!dirty.empty()) {
+        const int MIN_ROWS = 8; // 每线程至少重算的行数
+        int parts = workers(threads, static_cast<long long>(dirty.size()) / MIN_ROWS);
+        parallel(parts, [&](int p) {
+            std::vector<Bar> stack;
+            size_t lo = dirty.size() * p / parts, hi = dirty.size() * (p + 1) / parts;
+            for (size_t i = lo; i < hi; ++i) rowBest[dirty[i]] = largestRectangleInRow(rowHeights(dirty[i]), ncols, dirty[i], stack);
+        });
+        for (int r : dirty) isDirty[r] = 0;
+        dirty.clear();
+    }
+    Rect best{0, 0, 0, 0};
+    for (const Rect& x : rowBest)
+        if (x.area() > best.area()) best = x;
+    return best;
+}
+
+#endif // GRID_H
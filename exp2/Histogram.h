@@ -0,0 +1,211 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// 柱状图中的最大矩形：面积与下标一律为 64 位，数十亿根柱、高至 int 上限亦不溢出
+//
+// 单调栈中每项为 (高度, 起点)：以该高度为高的矩形最左可从起点开始。新柱到来时弹出高度不低于它的各项，
+// 被弹出者的矩形止于新柱之前；新柱继承最后弹出者的起点后入栈。等高者随之合并，
+// 栈中高度严格递增，栈长不超过不同高度的个数
+
+typedef long long Area;
+
+struct Bar {
+    int height;
+    long long start; // 以 height 为高的矩形的最左下标
+};
+
+// 流式扫描：逐根(或逐段)送入柱高，内存只与栈长有关，与柱数无关
+class RectangleScanner {
+public:
+    void push(int height) {
+        if (!stack.empty() && stack.back().height == height) { // 与栈顶等高：弹出再压入的结果不变
+            ++count;
+            return;
+        }
+        long long start = count;
+        while (!stack.empty() && stack.back().height >= height) {
+            best = std::max(best, static_cast<Area>(stack.back().height) * (count - stack.back().start));
+            start = stack.back().start;
+            stack.pop_back();
+        }
+        stack.push_back(Bar{height, start});
+        ++count;
+    }
+    void push(const int* heights, size_t n) {
+        for (size_t i = 0; i < n; ++i) push(heights[i]);
+    }
+    // 迄今送入部分的最大面积(视其后为高 0 的柱)；不影响继续送入
+    Area area() const {
+        Area a = best;
+        for (const Bar& b : stack) a = std::max(a, static_cast<Area>(b.height) * (count - b.start));
+        return a;
+    }
+    long long size() const { return count; }  // 已送入的柱数
+    size_t depth() const { return stack.size(); }
+
+private:
+    std::vector<Bar> stack;
+    long long count = 0;
+    Area best = 0;
+};
+
+// 整个柱状图已在内存中时的单调栈内核：Height 为整数柱高类型，Index 为能表示 n 的有符号下标类型
+// stack 与 tops 为调用者预先分配的连续空间，各至少 n + 1 项，函数内不再分配；
+// tops 与 stack 并列存放栈中各柱的高度，出栈比较时不必按下标回查 heights
+// 栈底放一个低于任何柱高的哨兵，循环中无需判断栈空；输入结束后另行清栈，循环中也无需判断末尾；
+// 最大值以条件传送更新。等高者不出栈，栈长至多 n + 1
+template <typename Height, typename Index>
+Area largestRectangleArea(const Height* heights, Index n, Index* stack, Height* tops) {
+    static_assert(std::is_integral<Height>::value && std::is_signed<Index>::value, "integral heights, signed indices");
+    Index top = 0;
+    stack[0] = -1;
+    tops[0] = std::numeric_limits<Height>::lowest();
+    Area best = 0;
+    for (Index i = 0; i < n; ++i) {
+        Height h = heights[i];
+        while (tops[top] > h) { // 弹出者的矩形右止于 i 之前，左止于其下一项之后
+            Area a = static_cast<Area>(tops[top]) * (i - stack[top - 1] - 1);
+            best = a > best ? a : best;
+            --top;
+        }
+        ++top;
+        stack[top] = i;
+        tops[top] = h;
+    }
+    for (; top > 0; --top) {
+        Area a = static_cast<Area>(tops[top]) * (n - stack[top - 1] - 1);
+        best = a > best ? a : best;
+    }
+    return best;
+}
+
+// 可反复使用的内核工作空间：容量不足时才重新分配(不初始化，未触及的页不占物理内存)
+template <typename Height, typename Index>
+class RectangleKernel {
+public:
+    Area operator()(const Height* heights, Index n) {
+        if (static_cast<size_t>(n) + 1 > capacity) {
+            capacity = static_cast<size_t>(n) + 1;
+            stack.reset(new Index[capacity]);
+            tops.reset(new Height[capacity]);
+        }
+        return largestRectangleArea(heights, n, stack.get(), tops.get());
+    }
+
+private:
+    std::unique_ptr<Index[]> stack;
+    std::unique_ptr<Height[]> tops;
+    size_t capacity = 0;
+};
+
+inline Area largestRectangleArea(const int* heights, size_t n) {
+    if (n < static_cast<size_t>(std::numeric_limits<int>::max()))
+        return RectangleKernel<int, int>()(heights, static_cast<int>(n));
+    return RectangleKernel<int, long long>()(heights, static_cast<long long>(n));
+}
+
+inline Area largestRectangleArea(const std::vector<int>& heights) {
+    return largestRectangleArea(heights.data(), heights.size());
+}
+
+// 从迭代器逐个读入(如 std::istream_iterator<int>)
+template <typename InputIt>
+Area largestRectangleArea(InputIt first, InputIt last) {
+    RectangleScanner scanner;
+    for (; first != last; ++first) scanner.push(*first);
+    return scanner.area();
+}
+
+// 从二进制文件(本机字节序的 int32 序列)分块读入，每次 HISTOGRAM_CHUNK 根
+const size_t HISTOGRAM_CHUNK = 1 << 20;
+
+inline Area largestRectangleAreaFile(const std::string& path) {
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) throw std::runtime_error("Cannot open " + path);
+    std::vector<int> chunk(HISTOGRAM_CHUNK);
+    RectangleScanner scanner;
+    size_t got;
+    while ((got = std::fread(chunk.data(), sizeof(int), chunk.size(), f)) > 0) scanner.push(chunk.data(), got);
+    bool failed = std::ferror(f) != 0;
+    std::fclose(f);
+    if (failed) throw std::runtime_error("Read error on " + path);
+    return scanner.area();
+}
+
+// 并行分治：各线程对一段独立扫描，再按段的先后合并。
+// 段内扫描时，栈底项(压入时栈为空者)的起点取决于前面各段，其面积留待合并时计算：
+//   left   段内的前缀最小值(高度严格递减，等高者只取第一个)，合并时依次与全局栈相接
+//   right  段末的栈(除栈底)，起点均在段内，合并时原样压入全局栈
+// 两者长度均不超过段内不同高度的个数
+struct HistogramChunk {
+    std::vector<Bar> left; // start 为该柱的下标
+    std::vector<Bar> right;
+    Area best = 0;         // 完全位于段内、起点确定的矩形中的最大面积
+};
+
+inline void scanChunk(const int* heights, long long lo, long long hi, HistogramChunk& chunk) {
+    std::vector<Bar> stack;
+    for (long long i = lo; i < hi; ++i) {
+        int h = heights[i];
+        long long start = i;
+        while (!stack.empty() && stack.back().height >= h) {
+            Bar b = stack.back();
+            stack.pop_back();
+            if (!stack.empty()) chunk.best = std::max(chunk.best, static_cast<Area>(b.height) * (i - b.start));
+            start = b.start;
+        }
+        if (stack.empty() && (chunk.left.empty() || chunk.left.back().height > h))
+            chunk.left.push_back(Bar{h, i});
+        stack.push_back(Bar{h, start});
+    }
+    if (!stack.empty()) chunk.right.assign(stack.begin() + 1, stack.end());
+}
+
+// threads 不大于 0 时取 CPU 核数；柱数不多时不分段
+inline Area largestRectangleAreaParallel(const int* heights, long long n, int threads = 0) {
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    const long long MIN_CHUNK = 1 << 16;
+    long long parts = std::min<long long>(threads, n / MIN_CHUNK);
+    if (parts <= 1) return largestRectangleArea(heights, n);
+
+    std::vector<HistogramChunk> chunks(parts);
+    std::vector<std::thread> workers;
+    for (long long p = 0; p < parts; ++p)
+        workers.emplace_back(scanChunk, heights, n * p / parts, n * (p + 1) / parts, std::ref(chunks[p]));
+    for (std::thread& w : workers) w.join();
+
+    Area best = 0;
+    std::vector<Bar> stack; // 全局栈
+    for (HistogramChunk& c : chunks) {
+        best = std::max(best, c.best);
+        for (const Bar& x : c.left) {
+            long long start = x.start;
+            while (!stack.empty() && stack.back().height >= x.height) {
+                best = std::max(best, static_cast<Area>(stack.back().height) * (x.start - stack.back().start));
+                start = stack.back().start;
+                stack.pop_back();
+            }
+            stack.push_back(Bar{x.height, start});
+        }
+        stack.insert(stack.end(), c.right.begin(), c.right.end());
+    }
+    for (const Bar& b : stack) best = std::max(best, static_cast<Area>(b.height) * (n - b.start));
+    return best;
+}
+
+inline Area largestRectangleAreaParallel(const std::vector<int>& heights, int threads = 0) {
+    return largestRectangleAreaParallel(heights.data(), static_cast<long long>(heights.size()), threads);
+}
+
+#endif // HISTOGRAM_H
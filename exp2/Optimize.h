@@ -0,0 +1,188 @@
+#ifndef OPTIMIZE_H
+#define OPTIMIZE_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "Stack.h"
+#include "Expression.h"
+
+// 程序优化：将后缀式程序还原为表达式树，相同的子树合而为一(成为有向无环图)，再重新生成指令
+//   常量折叠      运算数均为常量的子式当场求值；求值出错的保留原样，错误留到执行时报告
+//   公共子式消除  相同的子式只算一次，结果存入寄存器，再用到时取出；+ 与 * 的两个运算数不计次序
+//   强度削弱      x^k (k 为绝对值不超过 MAX_POW_INT 的整数常量) 改为反复平方，x^2 即 x*x，x^1 即 x；
+//                 反复平方的舍入误差随 |k| 累积，与 pow 至多相差约 |k| 个 ulp(x*x 正确舍入，pow 则未必，k = 2 时也可能差 1 ulp)
+// 不做结合律、分配律一类的变换：浮点运算并不满足这些定律
+// 优化本身要花时间，适合反复执行的程序(多组变量取值、executeBatch)
+
+const int MAX_POW_INT = 1024;
+
+class ExprDag {
+public:
+    explicit ExprDag(const Program& prog);
+    Program emit() const;
+
+private:
+    struct Node {
+        char op;      // 同 Instr::op
+        int arg;      // '$' 的变量槽号，'p' 的指数
+        int a, b;     // 运算数的结点号，无则为 -1
+        double value; // '#' 的值
+    };
+    typedef std::tuple<char, int, int, int, std::uint64_t> Key;
+
+    const Program& source;
+    std::vector<Node> nodes; // 运算数的结点号总小于其自身
+    std::map<Key, int> index;
+    int root;
+
+    int node(char op, int arg, int a, int b, double value = 0);
+    int constant(double value) { return node('#', 0, -1, -1, value); }
+    int unary(char op, int a);
+    int binary(char op, int a, int b);
+};
+
+// 结点(op, arg, a, b, value)：已有相同结点时直接返回其编号
+inline int ExprDag::node(char op, int arg, int a, int b, double value) {
+    std::uint64_t bits = 0;
+    if (op == '#') std::memcpy(&bits, &value, sizeof bits);
+    Key key(op, arg, a, b, bits);
+    std::map<Key, int>::iterator it = index.find(key);
+    if (it != index.end()) return it->second;
+    nodes.push_back(Node{op, arg, a, b, value});
+    int id = static_cast<int>(nodes.size()) - 1;
+    index.emplace(key, id);
+    return id;
+}
+
+inline int ExprDag::unary(char op, int a) {
+    if (nodes[a].op == '#') {
+        try {
+            return constant(calcu(op, nodes[a].value));
+        } catch (const std::exception&) {
+        }
+    }
+    return node(op, 0, a, -1);
+}
+
+inline int ExprDag::binary(char op, int a, int b) {
+    if (nodes[a].op == '#' && nodes[b].op == '#') {
+        try {
+            return constant(calcu(nodes[a].value, op, nodes[b].value));
+        } catch (const std::exception&) {
+        }
+    }
+    if (op == '^' && nodes[b].op == '#') {
+        double k = nodes[b].value;
+        if (k == std::floor(k) && std::fabs(k) <= MAX_POW_INT) {
+            if (k == 1) return a;
+            return node('p', static_cast<int>(k), a, -1);
+        }
+    }
+    if ((op == '+' || op == '*') && a > b) std::swap(a, b);
+    return node(op, 0, a, b);
+}
+
+// 按后缀式依次建立结点，运算数均为常量时即行折叠
+inline ExprDag::ExprDag(const Program& prog) : source(prog) {
+    std::vector<int> stack;
+    for (const Instr& in : prog.code) {
+        int a, b;
+        switch (in.op) {
+            case '#': stack.push_back(constant(prog.consts[in.arg])); break;
+            case '$': stack.push_back(node('$', in.arg, -1, -1)); break;
+            case 'p':
+                stack.back() = node('p', in.arg, stack.back(), -1);
+                break;
+            case '!': case 's': case 'c': case 't': case 'l':
+                stack.back() = unary(in.op, stack.back());
+                break;
+            case '+': case '-': case '*': case '/': case '^':
+                b = stack.back();
+                stack.pop_back();
+                a = stack.back();
+                stack.back() = binary(in.op, a, b);
+                break;
+            default:
+                throw std::invalid_argument("Cannot optimize instruction");
+        }
+    }
+    if (stack.size() != 1)
+        throw std::invalid_argument("Malformed program");
+    root = stack.back();
+}
+
+// 生成指令：后序遍历有向无环图，被引用多次的内部结点首次算出后存入寄存器
+inline Program ExprDag::emit() const {
+    int n = static_cast<int>(nodes.size());
+    std::vector<int> uses(n, 0); // 自根可达的结点被引用的次数
+    std::vector<char> reachable(n, 0);
+    reachable[root] = 1;
+    for (int i = root; i >= 0; --i) {
+        if (!reachable[i]) continue;
+        for (int c : {nodes[i].a, nodes[i].b})
+            if (c >= 0) {
+                ++uses[c];
+                reachable[c] = 1;
+            }
+    }
+
+    Program prog;
+    prog.vars = source.vars;
+    std::map<std::uint64_t, int> pool; // 常量去重
+    std::vector<int> reg(n, -1);
+    int depth = 0;
+    auto push = [&](char op, int arg) {
+        prog.code.push_back(Instr{op, arg});
+        if (op == '#' || op == '$' || op == 'L') {
+            if (++depth > prog.depth) prog.depth = depth;
+        } else if (optrIndex(op) >= 0 && op != '!') {
+            --depth;
+        }
+    };
+
+    Stack<std::pair<int, bool>> todo; // (结点, 运算数是否已生成)；不用递归，极深的表达式也无妨
+    todo.Push(std::make_pair(root, false));
+    while (!todo.IsEmpty()) {
+        std::pair<int, bool> t = todo.Pop();
+        int i = t.first;
+        const Node& x = nodes[i];
+        if (reg[i] >= 0) {
+            push('L', reg[i]);
+        } else if (x.op == '#') {
+            std::uint64_t bits;
+            std::memcpy(&bits, &x.value, sizeof bits);
+            std::map<std::uint64_t, int>::iterator it = pool.find(bits);
+            if (it == pool.end()) {
+                it = pool.emplace(bits, static_cast<int>(prog.consts.size())).first;
+                prog.consts.push_back(x.value);
+            }
+            push('#', it->second);
+        } else if (x.op == '$') {
+            push('$', x.arg);
+        } else if (!t.second) {
+            todo.Push(std::make_pair(i, true));
+            if (x.b >= 0) todo.Push(std::make_pair(x.b, false));
+            todo.Push(std::make_pair(x.a, false));
+        } else {
+            push(x.op, x.arg);
+            if (uses[i] > 1) {
+                reg[i] = prog.regs++;
+                push('S', reg[i]);
+            }
+        }
+    }
+    return prog;
+}
+
+// 优化 prog，结果与原程序等价(变量槽号不变)
+inline Program optimize(const Program& prog) {
+    return ExprDag(prog).emit();
+}
+
+#endif // OPTIMIZE_H
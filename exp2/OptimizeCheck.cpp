@@ -0,0 +1,146 @@
+// 程序优化的校验：同一表达式分别以原程序与 optimize() 后的程序逐行求值，结果须相同
+// 覆盖常量折叠(含求值出错而保留原样的子式)、公共子式消除、x^k 的强度削弱与 '!' 的查表；
+// 除整数次幂 x^k(反复平方与 pow 的舍入至多相差约 |k| 个 ulp)外须逐位相同，出错时两边须抛出同类异常
+// 另检查优化后的指令确实如预期(折叠后无运算、公共子式只算一次等)
+// 全部一致时返回 0，否则打印不一致之处并返回 1
+//
+// 用法：optimize_check [--n 行数]
+
+#include <cmath>     // std::isnan, std::isinf
+#include <cstdint>   // std::int64_t
+#include <cstdio>    // std::printf
+#include <cstdlib>   // std::atoll
+#include <cstring>   // std::memcpy, std::strcmp
+#include <limits>    // std::numeric_limits
+#include <random>    // std::mt19937_64
+#include <stdexcept> // std::domain_error
+#include <string>
+#include <vector>
+#include "Expression.h"
+#include "Optimize.h"
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, char const* what) {
+    std::printf("%-40s %s\n", what, ok ? "ok" : "FAILED");
+    if (!ok) ++failures;
+}
+
+// a 与 b 之间相隔的 double 个数；同为 NaN 或相等时为 0
+long long ulps(double a, double b) {
+    if (a == b || (std::isnan(a) && std::isnan(b))) return 0;
+    if (std::isnan(a) || std::isnan(b)) return std::numeric_limits<long long>::max();
+    std::int64_t x, y;
+    std::memcpy(&x, &a, sizeof x);
+    std::memcpy(&y, &b, sizeof y);
+    if (x < 0) x = std::numeric_limits<std::int64_t>::min() - x; // 负数翻转为单调的次序
+    if (y < 0) y = std::numeric_limits<std::int64_t>::min() - y;
+    return x > y ? x - y : y - x;
+}
+
+// 按槽号排列的变量取值，每行一组：x 为一般实数，y 为正数，k 为 0..30 的整数
+std::vector<std::vector<double>> rows(Program const& prog, size_t n) {
+    std::mt19937_64 rng(2024);
+    std::uniform_real_distribution<double> unit(0, 1);
+    std::vector<std::vector<double>> out(n, std::vector<double>(prog.vars.size()));
+    for (size_t i = 0; i < n; ++i)
+        for (size_t v = 0; v < prog.vars.size(); ++v) {
+            std::string const& name = prog.vars[v];
+            out[i][v] = name == "y" ? unit(rng) * 10 + 0.01 : name == "k" ? static_cast<double>(rng() % 31) : unit(rng) * 200 - 100;
+        }
+    return out;
+}
+
+// 求值一行；出错时结果为 NaN，error 记下异常的种类(1 为 invalid_argument，2 为 domain_error)
+double run(Program const& prog, std::vector<double> const& vars, int& error) {
+    error = 0;
+    try {
+        return execute(prog, vars);
+    } catch (std::invalid_argument const&) {
+        error = 1;
+    } catch (std::domain_error const&) {
+        error = 2;
+    }
+    return std::numeric_limits<double>::quiet_NaN();
+}
+
+// 优化前后逐行比较：结果之差不超过 bound 个 ulp，出错的行两边须抛出同类异常
+void checkSame(char const* expr, long long bound, size_t n) {
+    Program plain = compile(expr), optimized = optimize(plain);
+    long long worst = 0;
+    bool sameErrors = true;
+    for (std::vector<double> const& vars : rows(plain, n)) {
+        int e1, e2;
+        double a = run(plain, vars, e1), b = run(optimized, vars, e2);
+        if (e1 != e2) sameErrors = false;
+        long long d = ulps(a, b);
+        if (d > worst) worst = d;
+    }
+    bool ok = sameErrors && worst <= bound;
+    std::printf("%-28s max %lld ulp (<= %lld)%s %s\n", expr, worst, bound, sameErrors ? "" : ", errors differ", ok ? "ok" : "FAILED");
+    if (!ok) ++failures;
+}
+
+// 优化后的程序中指令 op 的条数
+int count(char const* expr, char op) {
+    Program prog = optimize(compile(expr));
+    int c = 0;
+    for (Instr const& in : prog.code) c += in.op == op;
+    return c;
+}
+
+long long argValue(int argc, char** argv, char const* name, long long fallback) {
+    for (int i = 1; i + 1 < argc; ++i)
+        if (!std::strcmp(argv[i], name)) return std::atoll(argv[i + 1]);
+    return fallback;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t n = static_cast<size_t>(argValue(argc, argv, "--n", 10000));
+
+    // 常量折叠
+    checkSame("2*3+4", 0, n);
+    checkSame("x*(2+3)-4/8", 0, n);
+    checkSame("1/0+x", 0, n);
+    check(optimize(compile("2*3+4")).code.size() == 1, "fold: 2*3+4 is a single constant");
+    check(count("x*(2+3)-4/8", '+') == 0 && count("x*(2+3)-4/8", '/') == 0, "fold: constant subexpressions");
+    check(count("1/0+x", '/') == 1, "fold: 1/0 left for execute");
+
+    // 公共子式消除
+    checkSame("(x+y)*(x+y)", 0, n);
+    checkSame("(x+y)*(y+x)-x*y/(y*x)", 0, n);
+    checkSame("sin(x*y)+cos(x*y)-sin(y*x)", 0, n);
+    check(optimize(compile("(x+y)*(y+x)")).regs == 1 && count("(x+y)*(y+x)", '+') == 1, "cse: x+y computed once");
+    check(count("sin(x*y)+cos(x*y)-sin(y*x)", 's') == 1 && count("sin(x*y)+cos(x*y)-sin(y*x)", '*') == 1,
+          "cse: sin(x*y) computed once");
+
+    // 整数次幂
+    checkSame("x^2", 1, n);
+    checkSame("x^3", 3, n);
+    checkSame("y^10", 10, n);
+    checkSame("y^(0-3)", 3, n);
+    checkSame("x^(0-7)", 7, n);
+    checkSame("(y/10+0.5)^1000", 1000, n);
+    checkSame("x^1+y^0", 0, n);
+    checkSame("x^0.5+y^0.5", 0, n);
+    check(count("x^2", 'p') == 1 && count("x^2", '^') == 0, "pow: x^2 squared");
+    check(count("x^1", 'p') == 0 && count("x^1", '^') == 0, "pow: x^1 is x");
+    check(count("y^(0-3)", 'p') == 1, "pow: negative integer exponent");
+    check(count("x^0.5", '^') == 1 && count("y^1025", '^') == 1, "pow: others left to std::pow");
+
+    // 阶乘
+    checkSame("k!", 0, n);
+    checkSame("5!+k!", 0, n);
+    checkSame("3.7!*x", 0, n);
+    checkSame("(0-1)!+x", 0, n);
+    check(count("5!+k!", '!') == 1, "factorial: 5! folded");
+    check(count("(0-1)!+x", '!') == 1, "factorial: (0-1)! left for execute");
+    check(std::isinf(execute(optimize(compile("171!")), nullptr)), "factorial: 171! is inf");
+
+    std::printf("%zu rows: %s\n", n, failures ? "FAILED" : "optimized and plain programs agree");
+    return failures ? 1 : 0;
+}
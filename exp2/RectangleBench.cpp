@@ -0,0 +1,187 @@
+// 柱状图最大矩形的基准测试
+// 规模自 10^3 至 10^9 逐级扩大十倍，柱高分布为递增、递减、锯齿与随机，
+// 比较预分配栈的内核、流式扫描与并行分治三种求法，报告每根柱的耗时(ns)与峰值内存，结果以 JSON 输出
+// 数据由固定种子生成，各次运行的输入完全相同；放不进物理内存的规模跳过
+//
+// 用法：rectangle_bench [--max-n N] [--algo 名称] [--dist 名称] [--threads N] [--out 文件]
+
+#include <chrono>    // std::chrono::steady_clock
+#include <cstdint>   // std::uint64_t
+#include <cstdio>    // std::printf, std::fprintf, std::fopen
+#include <cstdlib>   // std::atoll
+#include <cstring>   // std::strcmp
+#include <vector>    // std::vector
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>  // sysconf
+#endif
+#include "Histogram.h"
+
+namespace {
+
+enum Dist { SORTED, REVERSED, SAWTOOTH, RANDOM, DISTS };
+char const* const DIST_NAME[DISTS] = {"sorted", "reversed", "sawtooth", "random"};
+
+enum Algo { KERNEL, SCANNER, PARALLEL, ALGOS };
+char const* const ALGO_NAME[ALGOS] = {"kernel", "scanner", "parallel"};
+
+int const MAX_REPEATS = 5;      // 每种组合至多重复次数
+double const MIN_SECONDS = 0.2; // 累计耗时达到此值即不再重复
+long long const SAWTOOTH_PERIOD = 1000;
+
+volatile Area sink; // 防止结果被优化掉
+
+// splitmix64：固定种子的确定性伪随机数
+struct SplitMix {
+    std::uint64_t state;
+    std::uint64_t operator()() {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+};
+
+std::vector<int> generate(Dist dist, long long n) {
+    std::vector<int> data(n);
+    SplitMix rng{static_cast<std::uint64_t>(n) * DISTS + dist};
+    for (long long i = 0; i < n; ++i) {
+        switch (dist) {
+        case SORTED: data[i] = static_cast<int>(i % 0x7FFFFFFF); break;
+        case REVERSED: data[i] = static_cast<int>((n - i) % 0x7FFFFFFF); break;
+        case SAWTOOTH: data[i] = static_cast<int>(i % SAWTOOTH_PERIOD); break;
+        default: data[i] = static_cast<int>(rng() >> 33); break;
+        }
+    }
+    return data;
+}
+
+// 峰值内存：Linux 上每种组合开始前清零进程的 VmHWM，结束后读取；其他平台不报告
+bool resetPeak() {
+#ifdef __linux__
+    std::FILE* f = std::fopen("/proc/self/clear_refs", "w");
+    if (!f) return false;
+    bool ok = std::fputs("5", f) >= 0;
+    return std::fclose(f) == 0 && ok;
+#else
+    return false;
+#endif
+}
+
+long long peakBytes() {
+    long long kb = -1;
+#ifdef __linux__
+    std::FILE* f = std::fopen("/proc/self/status", "r");
+    if (!f) return -1;
+    char line[256];
+    while (std::fgets(line, sizeof line, f))
+        if (!std::strncmp(line, "VmHWM:", 6)) std::sscanf(line + 6, "%lld", &kb);
+    std::fclose(f);
+#endif
+    return kb < 0 ? -1 : kb * 1024;
+}
+
+// 物理内存(字节)，未知时返回 0
+long long physicalMemory() {
+#if defined(_SC_PHYS_PAGES) && defined(_SC_PAGESIZE)
+    return static_cast<long long>(sysconf(_SC_PHYS_PAGES)) * sysconf(_SC_PAGESIZE);
+#else
+    return 0;
+#endif
+}
+
+struct Result {
+    double nsPerBar;
+    int repeats;
+    Area area;
+};
+
+// 取多次中的最短者；内核的工作空间在各次之间复用，下标能以 int 表示时用 int
+Result measure(Algo algo, std::vector<int> const& data, int threads) {
+    typedef std::chrono::steady_clock Clock;
+    Result result = {};
+    RectangleKernel<int, int> kernel;
+    RectangleKernel<int, long long> wideKernel;
+    double best = 0, total = 0;
+    long long n = static_cast<long long>(data.size());
+    while (result.repeats < MAX_REPEATS && (result.repeats == 0 || total < MIN_SECONDS)) {
+        Clock::time_point start = Clock::now();
+        switch (algo) {
+        case KERNEL:
+            result.area = n < 0x7FFFFFFF ? kernel(data.data(), static_cast<int>(n)) : wideKernel(data.data(), n);
+            break;
+        case SCANNER: {
+            RectangleScanner scanner;
+            scanner.push(data.data(), data.size());
+            result.area = scanner.area();
+            break;
+        }
+        default: result.area = largestRectangleAreaParallel(data.data(), n, threads); break;
+        }
+        double t = std::chrono::duration<double>(Clock::now() - start).count();
+        sink = result.area;
+        if (result.repeats++ == 0 || t < best) best = t;
+        total += t;
+    }
+    result.nsPerBar = best * 1e9 / static_cast<double>(n);
+    return result;
+}
+
+long long argValue(int argc, char** argv, char const* name, long long fallback) {
+    for (int i = 1; i + 1 < argc; ++i)
+        if (!std::strcmp(argv[i], name)) return std::atoll(argv[i + 1]);
+    return fallback;
+}
+
+char const* argString(int argc, char** argv, char const* name) {
+    for (int i = 1; i + 1 < argc; ++i)
+        if (!std::strcmp(argv[i], name)) return argv[i + 1];
+    return nullptr;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    long long maxN = argValue(argc, argv, "--max-n", 1000000000); // 最大规模
+    int threads = static_cast<int>(argValue(argc, argv, "--threads", 0)); // 并行求法的线程数，0 为 CPU 核数
+    char const* onlyAlgo = argString(argc, argv, "--algo");
+    char const* onlyDist = argString(argc, argv, "--dist");
+    char const* outPath = argString(argc, argv, "--out");
+
+    std::FILE* out = outPath ? std::fopen(outPath, "w") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "cannot open %s\n", outPath);
+        return 1;
+    }
+    long long memory = physicalMemory();
+    std::fprintf(out, "{\n  \"compiler\": \"%s\",\n  \"results\": [", __VERSION__);
+    bool first = true;
+    for (long long n = 1000; n <= maxN; n *= 10) {
+        // 输入 4 字节/柱；递增时流式扫描的栈达 16 字节/柱，扩容时新旧两份并存
+        if (memory > 0 && n * 36 > memory / 5 * 4) {
+            std::fprintf(stderr, "n=%lld skipped: needs about %lld MB\n", n, n * 36 >> 20);
+            continue;
+        }
+        for (int d = 0; d < DISTS; ++d) {
+            if (onlyDist && std::strcmp(onlyDist, DIST_NAME[d])) continue;
+            std::vector<int> data = generate(static_cast<Dist>(d), n);
+            for (int a = 0; a < ALGOS; ++a) {
+                if (onlyAlgo && std::strcmp(onlyAlgo, ALGO_NAME[a])) continue;
+                bool peak = resetPeak();
+                Result r = measure(static_cast<Algo>(a), data, threads);
+                long long bytes = peak ? peakBytes() : -1;
+                std::fprintf(stderr, "%-9s %-9s n=%-11lld %8.2f ns/bar %10.1f MB peak\n", ALGO_NAME[a], DIST_NAME[d], n,
+                             r.nsPerBar, bytes / 1048576.0);
+                std::fprintf(out, "%s\n    {\"algorithm\": \"%s\", \"distribution\": \"%s\", \"n\": %lld, "
+                                  "\"repeats\": %d, \"ns_per_bar\": %.3f, \"area\": %lld, ",
+                             first ? "" : ",", ALGO_NAME[a], DIST_NAME[d], n, r.repeats, r.nsPerBar, r.area);
+                if (bytes >= 0) std::fprintf(out, "\"peak_bytes\": %lld}", bytes);
+                else std::fprintf(out, "\"peak_bytes\": null}");
+                std::fflush(out);
+                first = false;
+            }
+        }
+    }
+    std::fprintf(out, "\n  ]\n}\n");
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
@@ -0,0 +1,112 @@
+#ifndef STACK_H
+#define STACK_H
+
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+// 栈：元素不超过 N 个时存放于对象内部的缓冲区，超出后转至堆上，容量按倍增扩展
+// 空栈上的 Top()/Pop() 抛出 std::out_of_range；不做任何输出
+template <typename T, int N = 16>
+class Stack {
+    static_assert(N > 0, "Stack requires N > 0");
+public:
+    explicit Stack(int size = N);
+    ~Stack();
+    Stack(const Stack&) = delete;
+    Stack& operator=(const Stack&) = delete;
+    bool IsEmpty() const { return top == -1; }
+    int Size() const { return top + 1; }
+    int Capacity() const { return capacity; }
+    T& Top();
+    void Push(const T& x);
+    void Push(T&& x);
+    template <typename... Args>
+    T& Emplace(Args&&... args); // 在栈顶就地构造元素
+    T Pop();                    // 弹出栈顶元素(移出而非复制)
+    void Clear();
+    void Reserve(int size);     // 预留空间，使容量至少为 size
+private:
+    int capacity;
+    int top;
+    T* values;
+    alignas(T) unsigned char buffer[sizeof(T) * N]; // 内嵌缓冲区
+
+    T* inlineValues() { return reinterpret_cast<T*>(buffer); }
+    void reallocate(int size);
+};
+
+template <typename T, int N>
+Stack<T, N>::Stack(int size) : capacity(N), top(-1), values(inlineValues()) {
+    if (size > N) reallocate(size);
+}
+
+template <typename T, int N>
+Stack<T, N>::~Stack() {
+    Clear();
+    if (values != inlineValues()) ::operator delete(values);
+}
+
+// 迁移至容量为 size 的堆空间
+template <typename T, int N>
+void Stack<T, N>::reallocate(int size) {
+    T* p = static_cast<T*>(::operator new(sizeof(T) * size));
+    for (int i = 0; i <= top; ++i) {
+        ::new (static_cast<void*>(p + i)) T(std::move(values[i]));
+        values[i].~T();
+    }
+    if (values != inlineValues()) ::operator delete(values);
+    values = p;
+    capacity = size;
+}
+
+template <typename T, int N>
+void Stack<T, N>::Reserve(int size) {
+    if (size > capacity) reallocate(size);
+}
+
+template <typename T, int N>
+void Stack<T, N>::Push(const T& x) {
+    Emplace(x);
+}
+
+template <typename T, int N>
+void Stack<T, N>::Push(T&& x) {
+    Emplace(std::move(x));
+}
+
+template <typename T, int N>
+template <typename... Args>
+T& Stack<T, N>::Emplace(Args&&... args) {
+    if (top + 1 == capacity) { // 参数可能引用栈中元素，须在扩容前构造
+        T x(std::forward<Args>(args)...);
+        reallocate(capacity * 2);
+        ::new (static_cast<void*>(values + top + 1)) T(std::move(x));
+    } else {
+        ::new (static_cast<void*>(values + top + 1)) T(std::forward<Args>(args)...);
+    }
+    return values[++top];
+}
+
+template <typename T, int N>
+T Stack<T, N>::Pop() {
+    if (IsEmpty())
+        throw std::out_of_range("Stack is empty");
+    T x(std::move(values[top]));
+    values[top--].~T();
+    return x;
+}
+
+template <typename T, int N>
+T& Stack<T, N>::Top() {
+    if (IsEmpty())
+        throw std::out_of_range("Stack is empty");
+    return values[top];
+}
+
+template <typename T, int N>
+void Stack<T, N>::Clear() {
+    while (top >= 0) values[top--].~T();
+}
+
+#endif // STACK_H
@@ -0,0 +1,91 @@
+// 栈的吞吐量测试：单线程下的 Stack，以及多线程共享时无锁的 ConcurrentStack 与加锁的 Stack
+// 用法：stack_bench [每线程操作数] [最大线程数]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <stack>
+#include <thread>
+#include <vector>
+#include "Stack.h"
+#include "ConcurrentStack.h"
+
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+static double seconds(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+// 单线程：连续 Push n 个再全部 Pop
+template <typename S>
+static double sequential(S& s, long n) {
+    Clock::time_point start = Clock::now();
+    long sum = 0;
+    for (long i = 0; i < n; ++i) s.Push(static_cast<int>(i));
+    for (long i = 0; i < n; ++i) sum += s.Pop();
+    if (sum != n * (n - 1) / 2) printf("checksum mismatch\n");
+    return seconds(start);
+}
+
+static double sequentialStd(long n) {
+    std::stack<int> s;
+    Clock::time_point start = Clock::now();
+    long sum = 0;
+    for (long i = 0; i < n; ++i) s.push(static_cast<int>(i));
+    for (long i = 0; i < n; ++i) { sum += s.top(); s.pop(); }
+    if (sum != n * (n - 1) / 2) printf("checksum mismatch\n");
+    return seconds(start);
+}
+
+// 多线程：各线程交替执行 Push 与 Pop 共 ops 次，pop 为 bool(int&) 形式的出栈
+template <typename Push, typename Pop>
+static double concurrent(int threads, long ops, Push push, Pop pop) {
+    vector<thread> workers;
+    Clock::time_point start = Clock::now();
+    for (int t = 0; t < threads; ++t)
+        workers.emplace_back([=] {
+            int x;
+            for (long i = 0; i < ops / 2; ++i) {
+                push(static_cast<int>(i));
+                while (!pop(x)) {}
+            }
+        });
+    for (thread& w : workers) w.join();
+    return seconds(start);
+}
+
+int main(int argc, char** argv) {
+    long ops = argc > 1 ? atol(argv[1]) : 2000000;
+    int maxThreads = argc > 2 ? atoi(argv[2]) : max(4u, thread::hardware_concurrency());
+
+    printf("single thread, %ld push + %ld pop\n", ops, ops);
+    Stack<int> s;
+    printf("  %-24s %8.1f Mops/s\n", "Stack<int>", 2 * ops / sequential(s, ops) / 1e6);
+    printf("  %-24s %8.1f Mops/s\n", "std::stack<int>", 2 * ops / sequentialStd(ops) / 1e6);
+
+    printf("shared stack, %ld ops per thread\n", ops);
+    printf("  %-8s %16s %16s\n", "threads", "ConcurrentStack", "mutex + Stack");
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        ConcurrentStack<int> cs;
+        double lockFree = concurrent(threads, ops,
+            [&](int x) { cs.Push(x); },
+            [&](int& x) { return cs.TryPop(x); });
+
+        Stack<int> ls;
+        mutex m;
+        double locked = concurrent(threads, ops,
+            [&](int x) { lock_guard<mutex> g(m); ls.Push(x); },
+            [&](int& x) {
+                lock_guard<mutex> g(m);
+                if (ls.IsEmpty()) return false;
+                x = ls.Pop();
+                return true;
+            });
+        double total = static_cast<double>(ops) * threads;
+        printf("  %-8d %10.1f Mops/s %10.1f Mops/s\n", threads, total / lockFree / 1e6, total / locked / 1e6);
+    }
+    return 0;
+}
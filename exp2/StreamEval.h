@@ -0,0 +1,165 @@
+#ifndef STREAMEVAL_H
+#define STREAMEVAL_H
+
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Expression.h"
+
+// 文件批量求值：输入每行一个表达式，输出每行一个结果(或 "Error: ..."，空行照原样保留)，行序不变
+// 主线程按 STREAM_CHUNK 字节分块读入，在最后一个换行处切开，余下部分并入下一块；
+// 各块交由工作线程逐行编译、执行，主线程再按块的先后写出。
+// 在途的块数有上限，内存占用与文件大小无关
+
+const size_t STREAM_CHUNK = 1 << 22;
+
+struct StreamStats {
+    size_t lines = 0;  // 表达式行数(不含空行)
+    size_t errors = 0; // 其中出错的行数
+    size_t bytes = 0;  // 输入字节数
+    double seconds = 0;
+};
+
+// 求值 [begin, end) 中的各行，结果追加到 out
+inline void evaluateLines(const char* begin, const char* end, std::string& out, StreamStats& stats) {
+    Program prog; // 各行复用同一份程序空间
+    char buf[32];
+    while (begin < end) {
+        const char* eol = begin;
+        while (eol < end && *eol != '\n') ++eol;
+        const char* last = eol;
+        if (last > begin && last[-1] == '\r') --last;
+        const char* p = begin;
+        while (p < last && (*p == ' ' || *p == '\t')) ++p;
+        if (p < last) {
+            ++stats.lines;
+            try {
+                compile(begin, last, prog);
+                if (!prog.vars.empty())
+                    throw std::invalid_argument("Unbound variable: " + prog.vars[0]);
+                std::to_chars_result r = std::to_chars(buf, buf + sizeof buf, execute(prog, nullptr));
+                out.append(buf, r.ptr);
+            } catch (const std::exception& e) {
+                ++stats.errors;
+                out += "Error: ";
+                out += e.what();
+            }
+        }
+        out += '\n';
+        begin = eol + 1;
+    }
+}
+
+// 以 threads 个工作线程求值文件 input，结果写入 output；文件无法打开或读写出错时抛出 std::runtime_error
+inline StreamStats evaluateFile(const std::string& input, const std::string& output, int threads) {
+    struct Chunk {
+        std::string text, result;
+        StreamStats stats;
+        bool done = false;
+    };
+    std::unique_ptr<FILE, int (*)(FILE*)> in(std::fopen(input.c_str(), "rb"), std::fclose);
+    if (!in) throw std::runtime_error("Cannot open " + input);
+    std::unique_ptr<FILE, int (*)(FILE*)> out(std::fopen(output.c_str(), "wb"), std::fclose);
+    if (!out) throw std::runtime_error("Cannot create " + output);
+    if (threads < 1) threads = 1;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::mutex m;
+    std::condition_variable ready, finished; // 有块待处理；有块处理完毕
+    std::deque<Chunk*> todo;
+    bool closed = false;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+        workers.emplace_back([&] {
+            for (;;) {
+                Chunk* c;
+                {
+                    std::unique_lock<std::mutex> lock(m);
+                    ready.wait(lock, [&] { return closed || !todo.empty(); });
+                    if (todo.empty()) return;
+                    c = todo.front();
+                    todo.pop_front();
+                }
+                c->result.reserve(c->text.size());
+                evaluateLines(c->text.data(), c->text.data() + c->text.size(), c->result, c->stats);
+                std::string().swap(c->text);
+                {
+                    std::lock_guard<std::mutex> lock(m);
+                    c->done = true;
+                }
+                finished.notify_all();
+            }
+        });
+
+    StreamStats total;
+    bool failed = false;
+    std::deque<std::unique_ptr<Chunk>> pending; // 已读入、尚未写出的块，按输入顺序
+    // 写出最早的块；wait 为 false 时若它尚未完成则不等待
+    auto flush = [&](bool wait) {
+        std::unique_ptr<Chunk>& c = pending.front();
+        {
+            std::unique_lock<std::mutex> lock(m);
+            if (wait) finished.wait(lock, [&] { return c->done; });
+            else if (!c->done) return false;
+        }
+        if (std::fwrite(c->result.data(), 1, c->result.size(), out.get()) != c->result.size()) failed = true;
+        total.lines += c->stats.lines;
+        total.errors += c->stats.errors;
+        pending.pop_front();
+        return true;
+    };
+
+    const size_t window = 2 * static_cast<size_t>(threads) + 2; // 在途块数的上限
+    std::string carry;                                         // 上一块最后一个换行之后的部分
+    for (bool eof = false; !eof;) {
+        std::unique_ptr<Chunk> c(new Chunk);
+        c->text.swap(carry);
+        size_t kept = c->text.size();
+        c->text.resize(kept + STREAM_CHUNK);
+        size_t got = std::fread(&c->text[kept], 1, STREAM_CHUNK, in.get());
+        c->text.resize(kept + got);
+        total.bytes += got;
+        if (got < STREAM_CHUNK) {
+            if (std::ferror(in.get())) failed = true;
+            eof = true;
+        } else {
+            size_t cut = c->text.rfind('\n');
+            if (cut == std::string::npos) { // 整块没有换行，并入下一块
+                carry.swap(c->text);
+                continue;
+            }
+            carry.assign(c->text, cut + 1, std::string::npos);
+            c->text.resize(cut + 1);
+        }
+        if (c->text.empty()) continue;
+        {
+            std::lock_guard<std::mutex> lock(m);
+            todo.push_back(c.get());
+        }
+        ready.notify_one();
+        pending.push_back(std::move(c));
+        while (!pending.empty() && flush(pending.size() >= window)) {}
+    }
+    while (!pending.empty()) flush(true);
+    {
+        std::lock_guard<std::mutex> lock(m);
+        closed = true;
+    }
+    ready.notify_all();
+    for (std::thread& w : workers) w.join();
+
+    if (std::fflush(out.get()) != 0) failed = true;
+    if (failed) throw std::runtime_error("I/O error while evaluating " + input);
+    total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return total;
+}
+
+#endif // STREAMEVAL_H
@@ -0,0 +1,220 @@
+#ifndef VECMATH_H
+#define VECMATH_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+// 定长数组上的向量化数学核：每次处理 VEC_BLOCK 个 double
+// 循环体内无分支、无库函数调用，编译器可将其自动向量化；
+// 在 x86-64 Linux 上另生成 AVX2 版本，运行时按 CPU 自动选用
+//
+// sin/cos/tan/log 采用 Cephes 的区间约简与多项式(有理)逼近，与 glibc 的 std 函数之差实测为：
+// sin、cos 至多 2 ulp，tan 至多 4 ulp(sin、cos 两个多项式相除，误差叠加)，log 至多 1 ulp；
+// 超出约简适用范围的输入(过大、非正、非有限值等)，以及临近 pi/2 整数倍、约简时抵消过多的三角函数输入，
+// 由 fixup 逐个改用 std 函数重算
+
+const int VEC_BLOCK = 256;
+
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__)
+#define VEC_CLONES __attribute__((target_clones("avx2", "default")))
+#else
+#define VEC_CLONES
+#endif
+
+#if defined(__GNUC__) && !defined(__clang__)
+#define VEC_IVDEP _Pragma("GCC ivdep")
+#else
+#define VEC_IVDEP
+#endif
+
+// 不关心浮点异常标志(结果不变)，编译器才肯将含比较的循环体转为无分支的混合运算
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC push_options
+#pragma GCC optimize("no-trapping-math")
+#endif
+
+namespace vecmath {
+
+// 逐元素二元运算
+VEC_CLONES static void add(const double* a, const double* b, double* y) {
+    VEC_IVDEP
+    for (int i = 0; i < VEC_BLOCK; ++i) y[i] = a[i] + b[i];
+}
+
+VEC_CLONES static void sub(const double* a, const double* b, double* y) {
+    VEC_IVDEP
+    for (int i = 0; i < VEC_BLOCK; ++i) y[i] = a[i] - b[i];
+}
+
+VEC_CLONES static void mul(const double* a, const double* b, double* y) {
+    VEC_IVDEP
+    for (int i = 0; i < VEC_BLOCK; ++i) y[i] = a[i] * b[i];
+}
+
+VEC_CLONES static void div(const double* a, const double* b, double* y) {
+    VEC_IVDEP
+    for (int i = 0; i < VEC_BLOCK; ++i) y[i] = a[i] / b[i];
+}
+
+// b 中是否有 0(前 m 个)
+static bool anyZero(const double* b, int m) {
+    int zeros = 0;
+    for (int i = 0; i < m; ++i) zeros += (b[i] == 0);
+    return zeros != 0;
+}
+
+// y = a^k，k 为整数：反复平方
+VEC_CLONES static void powInt(const double* a, long long k, double* y) {
+    bool negative = k < 0;
+    unsigned long long e = negative ? 0ull - static_cast<unsigned long long>(k) : static_cast<unsigned long long>(k);
+    double base[VEC_BLOCK];
+    VEC_IVDEP
+    for (int i = 0; i < VEC_BLOCK; ++i) { base[i] = a[i]; y[i] = 1; }
+    for (; e; e >>= 1) {
+        if (e & 1) {
+            VEC_IVDEP
+            for (int i = 0; i < VEC_BLOCK; ++i) y[i] *= base[i];
+        }
+        if (e > 1) {
+            VEC_IVDEP
+            for (int i = 0; i < VEC_BLOCK; ++i) base[i] *= base[i];
+        }
+    }
+    if (negative) {
+        VEC_IVDEP
+        for (int i = 0; i < VEC_BLOCK; ++i) y[i] = 1 / y[i];
+    }
+}
+
+// Cephes 的 sin/cos 约简常数：pi/4 拆为三段，逐段相减以保持精度
+const double FOPI = 1.27323954473516268615; // 4/pi
+const double DP1 = 7.85398125648498535156E-1;
+const double DP2 = 3.77489470793079817668E-8;
+const double DP3 = 2.69515142907905952645E-15;
+const double TRIG_LIMIT = 1.0e9; // 超过此值时约简失准(且 int 会溢出)
+const double TRIG_CANCEL = 1.0e-12; // 约简余数 |z| 小于 |x| 的此倍时相减抵消过多(x 临近 pi/2 的整数倍)
+
+// sin 与 cos 在 [-pi/4, pi/4] 上的逼近
+inline double sinPoly(double z, double zz) {
+    return z + z * zz * (((((1.58962301576546568060E-10 * zz - 2.50507477628578072866E-8) * zz
+        + 2.75573136213857245213E-6) * zz - 1.98412698295895385996E-4) * zz
+        + 8.33333333332211858878E-3) * zz - 1.66666666666666307295E-1);
+}
+
+inline double cosPoly(double zz) {
+    return 1.0 - 0.5 * zz + zz * zz * (((((-1.13585365213876817300E-11 * zz + 2.08757008419747316778E-9) * zz
+        - 2.75573141792967388112E-7) * zz + 2.48015872888517045348E-5) * zz
+        - 1.38888888888730564116E-3) * zz + 4.16666666666665929218E-2);
+}
+
+// 约简：|x| = j * pi/4 + z，j 为偶数，|z| <= pi/4；q 为 j/2 模 4 的余数
+inline double reduce(double ax, int& q) {
+    int j = static_cast<int>(ax * FOPI);
+    j = (j + 1) & ~1;
+    double y = j;
+    q = (j >> 1) & 3;
+    return ((ax - y * DP1) - y * DP2) - y * DP3;
+}
+
+// 须改用 std 函数的输入：超出约简范围(含非有限值)，或约简余数 z 相对 |x| 过小、相减抵消过多
+// 各核对这些输入输出 TRIG_FIXUP(NaN)，交由 trigFixup 重算
+const double TRIG_FIXUP = std::numeric_limits<double>::quiet_NaN();
+
+inline bool trigSuspect(double ax, double z) {
+    return !(ax < TRIG_LIMIT) | (std::fabs(z) < ax * TRIG_CANCEL);
+}
+
+// 以下各核用算术混合代替条件选择(q 为 0/1 时 q*a + (1-q)*b 精确等于 a 或 b)，使循环体无分支
+VEC_CLONES static void sin(const double* x, double* y) {
+    VEC_IVDEP
+    for (int i = 0; i < VEC_BLOCK; ++i) {
+        double ax = std::fabs(x[i]);
+        int q;
+        double z = reduce(ax < TRIG_LIMIT ? ax : 0, q), zz = z * z; // 超出范围者由 fixup 重算
+        double odd = q & 1;                    // 奇象限用 cos 多项式
+        double r = odd * cosPoly(zz) + (1 - odd) * sinPoly(z, zz);
+        double flip = (q >> 1) & 1;            // 第 2、3 象限为负
+        y[i] = trigSuspect(ax, z) ? TRIG_FIXUP : std::copysign(1.0, x[i]) * (1 - 2 * flip) * r;
+    }
+}
+
+VEC_CLONES static void cos(const double* x, double* y) {
+    VEC_IVDEP
+    for (int i = 0; i < VEC_BLOCK; ++i) {
+        double ax = std::fabs(x[i]);
+        int q;
+        double z = reduce(ax < TRIG_LIMIT ? ax : 0, q), zz = z * z;
+        double odd = q & 1;
+        double r = odd * sinPoly(z, zz) + (1 - odd) * cosPoly(zz);
+        double flip = ((q + 1) >> 1) & 1;      // 第 1、2 象限为负
+        y[i] = trigSuspect(ax, z) ? TRIG_FIXUP : (1 - 2 * flip) * r;
+    }
+}
+
+VEC_CLONES static void tan(const double* x, double* y) {
+    VEC_IVDEP
+    for (int i = 0; i < VEC_BLOCK; ++i) {
+        double ax = std::fabs(x[i]);
+        int q;
+        double z = reduce(ax < TRIG_LIMIT ? ax : 0, q), zz = z * z;
+        double s = sinPoly(z, zz), c = cosPoly(zz);
+        double odd = q & 1;                    // tan(z + k*pi/2)：k 为奇数时为 -cot(z)
+        double r = (odd * -c + (1 - odd) * s) / (odd * s + (1 - odd) * c);
+        y[i] = trigSuspect(ax, z) ? TRIG_FIXUP : std::copysign(1.0, x[i]) * r;
+    }
+}
+
+// 核中标为 TRIG_FIXUP 的 sin/cos/tan 结果改用 std 函数重算(前 m 个)；通常整块都无此标记
+inline void trigFixup(char op, const double* x, double* y, int m) {
+    int marked = 0;
+    for (int i = 0; i < m; ++i) marked += (y[i] != y[i]);
+    if (!marked) return;
+    for (int i = 0; i < m; ++i)
+        if (y[i] != y[i])
+            y[i] = op == 's' ? std::sin(x[i]) : op == 'c' ? std::cos(x[i]) : std::tan(x[i]);
+}
+
+// log：x = m * 2^e，m 在 [sqrt(1/2), sqrt(2)) 内，log(x) = e*ln2 + log(m)，
+// log(1 + t) 以 t - t^2/2 + t^3 P(t)/Q(t) 逼近，ln2 拆为两段相加
+VEC_CLONES static void log(const double* x, double* y) {
+    VEC_IVDEP
+    for (int i = 0; i < VEC_BLOCK; ++i) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &x[i], sizeof bits);
+        std::uint64_t ebits = (bits >> 52) | 0x4330000000000000ull; // 指数字段按 2^52 + k 装入 double
+        double e;
+        std::memcpy(&e, &ebits, sizeof e);
+        e -= 4503599627370496.0 + 1022.0;
+        std::uint64_t mbits = (bits & 0x000FFFFFFFFFFFFFull) | 0x3FE0000000000000ull; // m 在 [0.5, 1) 内
+        double m;
+        std::memcpy(&m, &mbits, sizeof m);
+        double small = m < 0.70710678118654752440; // m 过小时改取 2m，指数减一
+        e -= small;
+        double t = m * (1 + small) - 1.0;
+        double z = t * t;
+        double p = ((((1.01875663804580931796E-4 * t + 4.97494994976747001425E-1) * t
+            + 4.70579119878881725854E0) * t + 1.44989225341610930846E1) * t
+            + 1.79368678507819816313E1) * t + 7.70838733755885391666E0;
+        double q = ((((t + 1.12873587189167450590E1) * t + 4.52279145837532221105E1) * t
+            + 8.29875266912776603211E1) * t + 7.11544750618563894466E1) * t + 2.31251620126765340583E1;
+        double r = t * (z * p / q) - e * 2.121944400546905827679E-4 - 0.5 * z;
+        y[i] = (t + r) + e * 0.693359375;
+    }
+}
+
+// 非正、非正规、无穷与 NaN 的 log 输入改用 std::log(前 m 个)
+inline void logFixup(const double* x, double* y, int m) {
+    for (int i = 0; i < m; ++i)
+        if (!(x[i] >= 2.2250738585072014e-308 && x[i] <= 1.7976931348623157e308))
+            y[i] = std::log(x[i]);
+}
+
+} // namespace vecmath
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC pop_options
+#endif
+
+#endif // VECMATH_H
@@ -0,0 +1,145 @@
+#ifndef BITMAP_H
+#define BITMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+// 位图：按 64 位字紧凑存放，第 pos 位在第 pos / 64 个字中自高位起的第 pos % 64 位，
+// 因此任意连续 len (<= 64) 位至多跨两个字，可整段读写；末尾多余的位恒为 0
+// 以字节输出时逐字高位在前，即按位序每 8 位一个字节，末字节不足 8 位的补 0
+
+class Bitmap {
+private:
+    std::vector<std::uint64_t> words;
+    size_t nbits;
+
+    static size_t wordCount(size_t n) { return (n + 63) / 64; }
+
+public:
+    Bitmap(size_t size = 8) : words(wordCount(size), 0), nbits(size) {}
+    // 由字节序列构造(与 bytes() 互逆)，取前 size 位
+    Bitmap(const unsigned char* bytes, size_t size) : words(wordCount(size), 0), nbits(size) {
+        for (size_t i = 0; i < (size + 7) / 8; i++)
+            words[i / 8] |= static_cast<std::uint64_t>(bytes[i]) << (56 - i % 8 * 8);
+        if (size % 64) words.back() &= ~0ULL << (64 - size % 64);
+    }
+
+    void set(size_t pos, bool value) {
+        if (pos < nbits) {
+            std::uint64_t mask = 1ULL << (63 - pos % 64);
+            words[pos / 64] = value ? words[pos / 64] | mask : words[pos / 64] & ~mask;
+        }
+    }
+
+    bool test(size_t pos) const {
+        return pos < nbits ? (words[pos / 64] >> (63 - pos % 64)) & 1 : false;
+    }
+
+    // 自 pos 起的 len (1..64) 位，第 pos 位为结果的最高位；超出末尾的位读作 0
+    std::uint64_t getBits(size_t pos, int len) const {
+        size_t w = pos / 64;
+        int off = pos % 64;
+        if (w >= words.size()) return 0;
+        std::uint64_t hi = words[w] << off;
+        if (off + len > 64 && w + 1 < words.size()) hi |= words[w + 1] >> (64 - off);
+        return hi >> (64 - len);
+    }
+
+    // 以 value 的低 len (1..64) 位覆盖自 pos 起的各位；pos + len 不得超过 size()
+    void setBits(size_t pos, std::uint64_t value, int len) {
+        size_t w = pos / 64;
+        int off = pos % 64;
+        std::uint64_t mask = ~0ULL << (64 - len);
+        value = (value << (64 - len)) & mask;
+        words[w] = (words[w] & ~(mask >> off)) | (value >> off);
+        if (off + len > 64) words[w + 1] = (words[w + 1] & ~(mask << (64 - off))) | (value << (64 - off));
+    }
+
+    // 在末尾追加 value 的低 len (1..64) 位
+    void append(std::uint64_t value, int len) {
+        size_t pos = nbits;
+        expand(nbits + len);
+        setBits(pos, value, len);
+    }
+
+    void expand(size_t newSize) {
+        if (newSize > nbits) {
+            words.resize(wordCount(newSize), 0);
+            nbits = newSize;
+        }
+    }
+
+    void reserve(size_t size) { words.reserve(wordCount(size)); }
+
+    // 字节对齐的输出缓冲：(size() + 7) / 8 个字节
+    std::vector<unsigned char> bytes() const {
+        std::vector<unsigned char> out((nbits + 7) / 8);
+        for (size_t i = 0; i < out.size(); i++)
+            out[i] = static_cast<unsigned char>(words[i / 8] >> (56 - i % 8 * 8));
+        return out;
+    }
+
+    void print() const {
+        for (size_t i = 0; i < nbits; i++) {
+            std::cout << (test(i) ? "1" : "0");
+        }
+    }
+
+    size_t size() const {
+        return nbits;
+    }
+};
+
+// 位写入器：编码以 (bits, length) 成对追加到位图末尾，先在 64 位累加器中拼接，攒满一字才写入位图
+// 写完后须调用 finish() 写出累加器中的剩余位
+class BitWriter {
+private:
+    Bitmap& out;
+    std::uint64_t acc = 0; // 待写出的位，自高位起存放
+    int count = 0;         // 累加器中的位数，总小于 64
+
+public:
+    explicit BitWriter(Bitmap& bitmap) : out(bitmap) {}
+    ~BitWriter() { finish(); }
+    BitWriter(const BitWriter&) = delete;
+    BitWriter& operator=(const BitWriter&) = delete;
+
+    // 追加 bits 的低 length (0..64) 位，高位在前；bits 中其余的高位须为 0
+    void write(std::uint64_t bits, int length) {
+        if (length == 0) return;
+        int room = 64 - count;
+        if (length < room) {
+            acc |= bits << (room - length);
+            count += length;
+            return;
+        }
+        out.append(acc | bits >> (length - room), 64); // 填满一字
+        count = length - room;
+        acc = count ? bits << (64 - count) : 0;
+    }
+
+    void finish() {
+        if (count) out.append(acc >> (64 - count), count);
+        acc = 0;
+        count = 0;
+    }
+};
+
+// 位读取器：自位图开头依次读出；peek() 不移动读取位置，可一次取出至多 64 位用于查表
+class BitReader {
+private:
+    const Bitmap& in;
+    size_t pos = 0;
+
+public:
+    explicit BitReader(const Bitmap& bitmap) : in(bitmap) {}
+
+    std::uint64_t peek(int length) const { return in.getBits(pos, length); }
+    void skip(int length) { pos += length; }
+    size_t position() const { return pos; }
+    size_t remaining() const { return pos < in.size() ? in.size() - pos : 0; }
+};
+
+#endif // BITMAP_H
@@ -0,0 +1,124 @@
+#ifndef HUFFMAN_H
+#define HUFFMAN_H
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Bitmap.h"
+
+// Huffman 编码：码字的各位存于 bits 的低 length 位，高位在前
+// 权重为 int，总权重不超过 2^31，由斐波那契数的下界，码长不超过 45，放得进 64 位
+const int MAX_CODE_LENGTH = 64;
+
+struct HuffCode {
+    std::uint64_t bits = 0;
+    int length = 0;
+
+    void print() const {
+        for (int i = length - 1; i >= 0; i--) {
+            std::cout << ((bits >> i & 1) ? "1" : "0");
+        }
+    }
+};
+
+// 查表解码：不逐位沿树下行，而是一次取出 TABLE_BITS 位查表，直接得到字符与码长
+// 码长不超过 TABLE_BITS 的码字在主表中占 2^(TABLE_BITS - 码长) 项；更长的码字按前 TABLE_BITS 位分组，
+// 主表的对应项指向该组的次级表，次级表以其后的若干位(同样至多 TABLE_BITS 位)为下标，如此逐级下去
+// 各级表存放于同一数组中；主表 2^11 项共 16KB，可常驻 L1 缓存，常见的短码一次查表即得
+const int TABLE_BITS = 11;
+
+class HuffDecoder {
+private:
+    struct Entry {
+        std::uint32_t value;  // 字符；指向次级表时为其在 table 中的起点
+        std::uint8_t length;  // 本级消耗的位数，为 0 表示无此码字
+        std::uint8_t sub;     // 次级表的下标位数，为 0 表示本项即是字符
+    };
+    std::vector<Entry> table;
+    int rootBits = 0;  // 主表的下标位数
+    int maxLength = 0; // 最长码字的位数
+
+    // 为 ids 中各码字(前 depth 位已由上级表消耗)建表，返回表在 table 中的起点，bits 为其下标位数
+    std::uint32_t build(const HuffCode codes[], const char symbols[], const std::vector<int>& ids, int depth, int& bits) {
+        int longest = 0;
+        for (int id : ids) longest = std::max(longest, codes[id].length - depth);
+        bits = std::min(longest, TABLE_BITS);
+        std::uint32_t base = static_cast<std::uint32_t>(table.size());
+        table.resize(table.size() + (size_t(1) << bits), Entry{0, 0, 0});
+
+        std::map<std::uint64_t, std::vector<int>> longer; // 次级表的下标 -> 其中的码字
+        for (int id : ids) {
+            int rest = codes[id].length - depth;
+            std::uint64_t suffix = rest == 64 ? codes[id].bits : codes[id].bits & ((std::uint64_t(1) << rest) - 1);
+            if (rest > bits) {
+                longer[suffix >> (rest - bits)].push_back(id);
+                continue;
+            }
+            std::uint64_t first = suffix << (bits - rest);
+            for (std::uint64_t i = first; i < first + (std::uint64_t(1) << (bits - rest)); i++) {
+                if (table[base + i].length) throw std::invalid_argument("Huffman codes are not prefix-free");
+                table[base + i] = Entry{static_cast<unsigned char>(symbols[id]), static_cast<std::uint8_t>(rest), 0};
+            }
+        }
+        for (const auto& group : longer) {
+            if (table[base + group.first].length) throw std::invalid_argument("Huffman codes are not prefix-free");
+            int subBits;
+            std::uint32_t sub = build(codes, symbols, group.second, depth + bits, subBits);
+            table[base + group.first] = Entry{sub, static_cast<std::uint8_t>(bits), static_cast<std::uint8_t>(subBits)};
+        }
+        return base;
+    }
+
+public:
+    // codes[i] 为字符 symbols[i] 的码字，码长为 0 者不参与
+    HuffDecoder(const HuffCode codes[], const char symbols[], int n) {
+        std::vector<int> ids;
+        for (int i = 0; i < n; i++) {
+            if (codes[i].length > MAX_CODE_LENGTH) throw std::invalid_argument("Huffman code longer than 64 bits");
+            if (codes[i].length > 0) ids.push_back(i);
+            maxLength = std::max(maxLength, codes[i].length);
+        }
+        if (!ids.empty()) build(codes, symbols, ids, 0, rootBits);
+    }
+
+    // 将位图中的全部位解码，追加到 out 末尾；遇到无效的码字或末尾不完整时抛出 std::runtime_error
+    // 剩余不少于 64 位时一次取出 64 位，在其中连续查表，直到余下的位可能不足一个最长码字
+    void decode(const Bitmap& bits, std::string& out) const {
+        BitReader in(bits);
+        if (bits.size() && !rootBits) throw std::runtime_error("Invalid Huffman code");
+        while (in.remaining() >= 64) {
+            std::uint64_t window = in.peek(64);
+            int used = 0;
+            do {
+                Entry e = table[(window << used) >> (64 - rootBits)];
+                while (e.sub) {
+                    used += e.length;
+                    e = table[e.value + ((window << used) >> (64 - e.sub))];
+                }
+                if (!e.length) throw std::runtime_error("Invalid Huffman code");
+                used += e.length;
+                out.push_back(static_cast<char>(e.value));
+            } while (used + maxLength <= 64);
+            in.skip(used);
+        }
+        while (in.remaining() > 0) {
+            Entry e = table[in.peek(rootBits)];
+            while (e.sub) {
+                in.skip(e.length);
+                e = table[e.value + in.peek(e.sub)];
+            }
+            if (!e.length) throw std::runtime_error("Invalid Huffman code");
+            if (e.length > in.remaining()) throw std::runtime_error("Truncated Huffman data");
+            in.skip(e.length);
+            out.push_back(static_cast<char>(e.value));
+        }
+    }
+
+    size_t tableSize() const { return table.size(); }
+};
+
+#endif // HUFFMAN_H
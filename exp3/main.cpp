@@ -3,47 +3,15 @@
 #include <vector>
 #include <fstream>
 #include <string>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+#include "Bitmap.h"
+#include "Huffman.h"
 
 using namespace std;
 
-class Bitmap {
-private:
-    vector<bool> bits;
-public:
-    Bitmap(int size = 8) : bits(size, false) {}
-
-    void set(int pos, bool value) {
-        if (pos < bits.size()) {
-            bits[pos] = value;
-        }
-    }
-
-    bool test(int pos) const {
-        return pos < bits.size() ? bits[pos] : false;
-    }
-
-    void expand(int newSize) {
-        if (newSize > bits.size()) {
-            bits.resize(newSize, false);
-        }
-    }
-
-    void print() const {
-        for (bool bit : bits) {
-            cout << (bit ? "1" : "0");
-        }
-    }
-
-    int size() const {
-        return bits.size();
-    }
-};
-
-class HuffCode : public Bitmap {
-public:
-    HuffCode() : Bitmap(8) {}
-    HuffCode(int n) : Bitmap(n) {}
-};
 struct HuffChar {
     char ch;
     int weight;
@@ -92,41 +60,66 @@ private:
 
         root = pq.empty() ? nullptr : pq.top();
     }
-    void generateCodes(BinNode<HuffChar>* node, HuffCode& prefix, int length, HuffCode codeTable[]) {
+    void generateCodes(BinNode<HuffChar>* node, HuffCode prefix, HuffCode codeTable[]) {
         if (!node) return;
 
         if (!node->left && !node->right) {
             codeTable[node->data.ch - 0x20] = prefix;
-            codeTable[node->data.ch - 0x20].expand(length);
             return;
         }
+        if (prefix.length == MAX_CODE_LENGTH) {
+            throw length_error("Huffman code longer than 64 bits");
+        }
 
         if (node->left) {
-            prefix.set(length, 0);
-            generateCodes(node->left, prefix, length + 1, codeTable);
+            generateCodes(node->left, HuffCode{prefix.bits << 1, prefix.length + 1}, codeTable);
         }
 
         if (node->right) {
-            prefix.set(length, 1);
-            generateCodes(node->right, prefix, length + 1, codeTable);
+            generateCodes(node->right, HuffCode{prefix.bits << 1 | 1, prefix.length + 1}, codeTable);
         }
     }
+    static void release(BinNode<HuffChar>* node) {
+        if (!node) return;
+        release(node->left);
+        release(node->right);
+        delete node;
+    }
 public:
     HuffTree(int* freq, int n) {
         buildHuffTree(freq, n);
     }
     ~HuffTree() {
-        delete root; 
+        release(root);
     }
-    void generateCodes(HuffCode codeTable[], int n) {
+    HuffTree(const HuffTree&) = delete;
+    HuffTree& operator=(const HuffTree&) = delete;
+    void generateCodes(HuffCode codeTable[]) {
         if (!root) return;
-        HuffCode prefix(n * 8);  
-        generateCodes(root, prefix, 0, codeTable);
+        if (!root->left && !root->right) { // 只有一种字符时也用 1 位
+            codeTable[root->data.ch - 0x20] = HuffCode{0, 1};
+            return;
+        }
+        generateCodes(root, HuffCode(), codeTable);
+    }
+    // 逐位沿树下行的解码，用作查表解码的对照
+    void decode(const Bitmap& bits, string& out) const {
+        BinNode<HuffChar>* node = root;
+        for (size_t i = 0; i < bits.size(); i++) {
+            if (node->left || node->right) {
+                node = bits.test(i) ? node->right : node->left;
+            }
+            if (!node->left && !node->right) {
+                out.push_back(node->data.ch);
+                node = root;
+            }
+        }
+        if (node != root) throw runtime_error("Truncated Huffman data");
     }
     void printCodes(HuffCode codeTable[], int n) {
         cout << "Huffman编码表：\n";
         for (int i = 0; i < n; i++) {
-            if (codeTable[i].size() > 0) {
+            if (codeTable[i].length > 0) {
                 cout << char(i + 0x20) << ": ";
                 codeTable[i].print();
                 cout << "\n";
@@ -134,51 +127,153 @@ public:
         }
     }
 };
-void huffmanExample() {
-    const int N_CHAR = 95; 
-    string text = "aabaaab";
-    ifstream file("word.txt");
+const int N_CHAR = 95;
+const int FIRST_CHAR = 0x20; // 编码可打印字符 0x20..0x7e，其余字符(如换行)略去
+
+bool readText(const string& path, string& text) {
+    ifstream file(path);
     if (!file.is_open()) {
-        cerr << "无法打开文件 word.txt" << endl;
-        return;
+        cerr << "无法打开文件 " << path << endl;
+        return false;
     }
     string line;
     while (getline(file, line)) {
         text += line + "\n"; 
     }
-    file.close();
-    cout << "输入文本：" << text << endl;
-    int freq[N_CHAR] = {0}; 
+    return true;
+}
+
+void countFrequency(const string& text, int freq[]) {
     for (char c : text) {
         if (c >= 0x20 && c <= 0x7e) {  
-            freq[c - 0x20]++;
+            freq[c - FIRST_CHAR]++;
         }
     }
-    HuffTree tree(freq, N_CHAR);
-    HuffCode codeTable[N_CHAR];
-    tree.generateCodes(codeTable, N_CHAR);
-    tree.printCodes(codeTable, N_CHAR);
-    HuffCode encodedText(text.length() * 8);  
-    int encodedLen = 0;
+}
 
+// 各码字整段写入，结果的位数即编码长度
+Bitmap encode(const string& text, const HuffCode codeTable[]) {
+    Bitmap encoded(0);
+    encoded.reserve(text.length() * 8);
+    BitWriter writer(encoded);
     for (char c : text) {
         if (c >= 0x20 && c <= 0x7e) { 
-            HuffCode& code = codeTable[c - 0x20];
-            for (int j = 0; j < code.size(); j++) {
-                encodedText.set(encodedLen++, code.test(j));  
-            }
+            const HuffCode& code = codeTable[c - FIRST_CHAR];
+            writer.write(code.bits, code.length);
         }
     }
-    cout << "\n编码结果: ";
-    for (int i = 0; i < encodedLen; i += 8) {
-        for (int j = 0; j < 8 && i + j < encodedLen; j++) {
-            cout << (encodedText.test(i + j) ? "1" : "0");
+    writer.finish();
+    return encoded;
+}
+
+HuffDecoder makeDecoder(const HuffCode codeTable[]) {
+    char symbols[N_CHAR];
+    for (int i = 0; i < N_CHAR; i++) {
+        symbols[i] = char(i + FIRST_CHAR);
+    }
+    return HuffDecoder(codeTable, symbols, N_CHAR);
+}
+
+void huffmanExample() {
+    string text = "aabaaab";
+    if (!readText("word.txt", text)) {
+        return;
+    }
+    cout << "输入文本：" << text << endl;
+    int freq[N_CHAR] = {0}; 
+    countFrequency(text, freq);
+    HuffTree tree(freq, N_CHAR);
+    HuffCode codeTable[N_CHAR];
+    tree.generateCodes(codeTable);
+    tree.printCodes(codeTable, N_CHAR);
+    Bitmap encodedText = encode(text, codeTable);
+    vector<unsigned char> bytes = encodedText.bytes();
+    cout << "\n编码结果(" << encodedText.size() << " 位，" << bytes.size() << " 字节): ";
+    for (size_t i = 0; i < bytes.size(); i++) {
+        int n = i + 1 < bytes.size() || encodedText.size() % 8 == 0 ? 8 : encodedText.size() % 8;
+        for (int j = 0; j < n; j++) {
+            cout << ((bytes[i] >> (7 - j) & 1) ? "1" : "0");
         }
         cout << " ";
     }
     cout << endl;
+    string decoded;
+    makeDecoder(codeTable).decode(encodedText, decoded);
+    cout << "\n解码结果：" << decoded << endl;
+}
+
+// 往返校验：编码后转为字节(即存储的形式)，再由字节重建位图，分别以查表与逐位沿树两种方式解码，
+// 与原文(略去不编码的字符)比较，并报告各自的吞吐量
+// 用法：exp3_huffman --verify [文件] [重复次数]
+int verifyRoundTrip(const string& path, int repeats) {
+    typedef chrono::steady_clock Clock;
+    string text;
+    if (!readText(path, text)) {
+        return 1;
+    }
+    string expected;
+    for (char c : text) {
+        if (c >= 0x20 && c <= 0x7e) {
+            expected.push_back(c);
+        }
+    }
+    int freq[N_CHAR] = {0};
+    countFrequency(text, freq);
+    HuffTree tree(freq, N_CHAR);
+    HuffCode codeTable[N_CHAR];
+    tree.generateCodes(codeTable);
+    HuffDecoder decoder = makeDecoder(codeTable);
+
+    Bitmap encoded(0);
+    string fast, slow;
+    Clock::time_point t0 = Clock::now();
+    for (int r = 0; r < repeats; r++) {
+        encoded = encode(text, codeTable);
+    }
+    Clock::time_point t1 = Clock::now();
+    vector<unsigned char> bytes = encoded.bytes();
+    Bitmap restored(bytes.data(), encoded.size());
+    bool sameBytes = restored.size() == encoded.size() && restored.bytes() == bytes;
+    Clock::time_point t2 = Clock::now();
+    for (int r = 0; r < repeats; r++) {
+        fast.clear();
+        decoder.decode(restored, fast);
+    }
+    Clock::time_point t3 = Clock::now();
+    for (int r = 0; r < repeats; r++) {
+        slow.clear();
+        tree.decode(restored, slow);
+    }
+    Clock::time_point t4 = Clock::now();
+
+    double mb = double(expected.size()) * repeats / 1e6;
+    auto rate = [mb](Clock::time_point a, Clock::time_point b) {
+        return mb / max(chrono::duration<double>(b - a).count(), 1e-9);
+    };
+    cout << path << ": " << expected.size() << " 字符 -> " << encoded.size() << " 位(" << bytes.size()
+         << " 字节)，解码表 " << decoder.tableSize() << " 项\n";
+    cout << "编码         " << rate(t0, t1) << " MB/s\n";
+    cout << "查表解码     " << rate(t2, t3) << " MB/s\n";
+    cout << "逐位沿树解码 " << rate(t3, t4) << " MB/s\n";
+    if (!sameBytes) {
+        cout << "字节往返失败：由字节重建的位图与原位图不一致\n";
+    }
+    bool ok = sameBytes && fast == expected && slow == expected;
+    cout << (ok ? "往返校验通过" : "往返校验失败：解码结果与原文不一致") << endl;
+    return ok ? 0 : 1;
 }
-int main() {
+
+int main(int argc, char** argv) {
+    if (argc > 1 && string(argv[1]) == "--verify") {
+        string path = argc > 2 ? argv[2] : "word.txt";
+        int repeats = argc > 3 ? max(1, atoi(argv[3])) : 100;
+        try {
+            return verifyRoundTrip(path, repeats);
+        } catch (const exception& e) {
+            cerr << "错误：" << e.what() << endl;
+            return 1;
+        }
+    }
     huffmanExample();
     return 0;
 }